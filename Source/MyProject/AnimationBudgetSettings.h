@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AnimationBudgetSettings.generated.h"
+
+/**
+ *  Project settings for the animation budget allocator.
+ *  Controls how much game thread time budgeted skeletal meshes may spend on animation
+ *  and how their significance is derived from the local player's view.
+ */
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Animation Budget"))
+class UMyProjectAnimationBudgetSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/** If true, budgeted skeletal meshes will tick animation at reduced rates when over budget */
+	UPROPERTY(Config, EditAnywhere, Category="Budget")
+	bool bEnableBudget = true;
+
+	/** Game thread time allowed for budgeted animation each frame */
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta = (ClampMin = 0.1, ClampMax = 20, Units = "ms"))
+	float BudgetInMs = 1.0f;
+
+	/** Lowest tick quality the allocator will drop components to. 0 allows any tick rate up to MaxTickRate */
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta = (ClampMin = 0, ClampMax = 1))
+	float MinQuality = 0.0f;
+
+	/** Max number of frames a low significance component can go without ticking animation */
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta = (ClampMin = 1, ClampMax = 60))
+	int32 MaxTickRate = 10;
+
+	/** Max number of components that will interpolate between animation ticks */
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta = (ClampMin = 0, ClampMax = 256))
+	int32 MaxInterpolatedComponents = 32;
+
+	/** Distance from the view at which significance drops to its minimum */
+	UPROPERTY(Config, EditAnywhere, Category="Significance", meta = (ClampMin = 100, ClampMax = 100000, Units = "cm"))
+	float MaxSignificanceDistance = 5000.0f;
+
+	/** Significance multiplier for meshes that weren't rendered recently */
+	UPROPERTY(Config, EditAnywhere, Category="Significance", meta = (ClampMin = 0, ClampMax = 1))
+	float OffscreenSignificanceScale = 0.25f;
+};
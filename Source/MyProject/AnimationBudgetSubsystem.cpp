@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "AnimationBudgetSubsystem.h"
+#include "AnimationBudgetSettings.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "AnimationBudgetAllocatorParameters.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+void UAnimationBudgetSubsystem::RegisterMesh(USkeletalMeshComponent* Mesh)
+{
+	USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(Mesh);
+
+	if (!BudgetedMesh || FindMesh(Mesh))
+	{
+		return;
+	}
+
+	// we provide the significance ourselves
+	BudgetedMesh->SetAutoCalculateSignificance(false);
+
+	FBudgetedMesh& Entry = BudgetedMeshes.AddDefaulted_GetRef();
+	Entry.Mesh = BudgetedMesh;
+}
+
+void UAnimationBudgetSubsystem::UnregisterMesh(USkeletalMeshComponent* Mesh)
+{
+	BudgetedMeshes.RemoveAllSwap([Mesh](const FBudgetedMesh& Entry) { return Entry.Mesh.Get() == Mesh; });
+}
+
+void UAnimationBudgetSubsystem::SetFullRate(USkeletalMeshComponent* Mesh, bool bFullRate)
+{
+	FBudgetedMesh* Entry = FindMesh(Mesh);
+
+	if (!Entry || Entry->bFullRate == bFullRate)
+	{
+		return;
+	}
+
+	Entry->bFullRate = bFullRate;
+
+	// push the change right away so the next animation tick already runs at the right rate
+	UpdateSignificance(*Entry, FVector::ZeroVector, false);
+}
+
+UAnimationBudgetSubsystem::FBudgetedMesh* UAnimationBudgetSubsystem::FindMesh(const USkeletalMeshComponent* Mesh)
+{
+	return BudgetedMeshes.FindByPredicate([Mesh](const FBudgetedMesh& Entry) { return Entry.Mesh.Get() == Mesh; });
+}
+
+void UAnimationBudgetSubsystem::UpdateSignificance(FBudgetedMesh& Entry, const FVector& ViewLocation, bool bHasView) const
+{
+	USkeletalMeshComponentBudgeted* Mesh = Entry.Mesh.Get();
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+
+	if (!Mesh || !Allocator)
+	{
+		return;
+	}
+
+	// full rate meshes are always at max significance and are never skipped, even off screen
+	if (Entry.bFullRate)
+	{
+		Allocator->SetComponentSignificance(Mesh, 1.0f, true, true, false);
+		return;
+	}
+
+	const UMyProjectAnimationBudgetSettings* Settings = GetDefault<UMyProjectAnimationBudgetSettings>();
+
+	// scale significance down with the distance to the view
+	float Significance = 1.0f;
+
+	if (bHasView)
+	{
+		const float Distance = FVector::Dist(ViewLocation, Mesh->GetComponentLocation());
+		Significance = 1.0f - FMath::Clamp(Distance / Settings->MaxSignificanceDistance, 0.0f, 1.0f);
+	}
+
+	// meshes that aren't on screen matter less
+	if (!Mesh->WasRecentlyRendered(0.1f))
+	{
+		Significance *= Settings->OffscreenSignificanceScale;
+	}
+
+	Allocator->SetComponentSignificance(Mesh, Significance);
+}
+
+bool UAnimationBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAnimationBudgetSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(&InWorld);
+
+	if (!Allocator)
+	{
+		return;
+	}
+
+	const UMyProjectAnimationBudgetSettings* Settings = GetDefault<UMyProjectAnimationBudgetSettings>();
+
+	// copy the project settings into the allocator parameters
+	FAnimationBudgetAllocatorParameters Parameters;
+	Parameters.BudgetInMs = Settings->BudgetInMs;
+	Parameters.MinQuality = Settings->MinQuality;
+	Parameters.MaxTickRate = Settings->MaxTickRate;
+	Parameters.MaxInterpolatedComponents = Settings->MaxInterpolatedComponents;
+
+	Allocator->SetParameters(Parameters);
+	Allocator->SetEnabled(Settings->bEnableBudget);
+}
+
+void UAnimationBudgetSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// get the local player's view location
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasView = false;
+
+	if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		bHasView = true;
+	}
+
+	for (int32 i = BudgetedMeshes.Num() - 1; i >= 0; --i)
+	{
+		// drop meshes that were destroyed without unregistering
+		if (!BudgetedMeshes[i].Mesh.IsValid())
+		{
+			BudgetedMeshes.RemoveAtSwap(i, EAllowShrinking::No);
+			continue;
+		}
+
+		UpdateSignificance(BudgetedMeshes[i], ViewLocation, bHasView);
+	}
+}
+
+TStatId UAnimationBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAnimationBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UAnimationBudgetSubsystem::Deinitialize()
+{
+	BudgetedMeshes.Empty();
+
+	Super::Deinitialize();
+}
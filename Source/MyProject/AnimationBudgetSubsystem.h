@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AnimationBudgetSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+class USkeletalMeshComponentBudgeted;
+
+/**
+ *  Feeds significance to the animation budget allocator for enemy and NPC meshes.
+ *  Significance is based on distance to the local player's view and whether the mesh was rendered.
+ *  Meshes flagged as full rate, such as attacking enemies, are never skipped so their notifies stay frame accurate.
+ */
+UCLASS()
+class UAnimationBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** A budgeted mesh tracked by this subsystem */
+	struct FBudgetedMesh
+	{
+		/** Mesh component */
+		TWeakObjectPtr<USkeletalMeshComponentBudgeted> Mesh;
+
+		/** If true, the mesh always ticks animation at full rate */
+		bool bFullRate = false;
+	};
+
+	/** Tracked meshes */
+	TArray<FBudgetedMesh> BudgetedMeshes;
+
+public:
+
+	/** Starts tracking significance for the mesh. Ignored if the mesh isn't budgeted */
+	void RegisterMesh(USkeletalMeshComponent* Mesh);
+
+	/** Stops tracking significance for the mesh */
+	void UnregisterMesh(USkeletalMeshComponent* Mesh);
+
+	/** Forces the mesh to tick animation every frame, or returns it to significance based budgeting */
+	void SetFullRate(USkeletalMeshComponent* Mesh, bool bFullRate);
+
+protected:
+
+	/** Returns the tracked entry for the mesh, or nullptr */
+	FBudgetedMesh* FindMesh(const USkeletalMeshComponent* Mesh);
+
+	/** Passes the significance for a single mesh to the allocator */
+	void UpdateSignificance(FBudgetedMesh& Entry, const FVector& ViewLocation, bool bHasView) const;
+
+public:
+
+	/** Only create the subsystem for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Applies the project budget settings to the allocator */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Updates the significance of all tracked meshes */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+};
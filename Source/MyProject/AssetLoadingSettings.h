@@ -0,0 +1,23 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AssetLoadingSettings.generated.h"
+
+/**
+ *  Project settings for deferred asset loading.
+ *  Controls which soft referenced assets are streamed in asynchronously instead of being loaded on first use.
+ */
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Asset Loading"))
+class UMyProjectAssetLoadingSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/** If true, player controllers stream in their mobile controls widget class and add the widget once it's loaded. Otherwise the class is loaded and the widget added during BeginPlay */
+	UPROPERTY(Config, EditAnywhere, Category="Touch Controls")
+	bool bAsyncLoadMobileControls = false;
+};
@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CharacterMovementProfile.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/DataValidation.h"
+
+#define LOCTEXT_NAMESPACE "CharacterMovementProfile"
+
+void FCharacterMovementProfile::ApplyTo(UCharacterMovementComponent* MovementComponent) const
+{
+	check(MovementComponent);
+
+	MovementComponent->GravityScale = GravityScale;
+	MovementComponent->MaxAcceleration = MaxAcceleration;
+	MovementComponent->Mass = Mass;
+	MovementComponent->BrakingFrictionFactor = BrakingFrictionFactor;
+	MovementComponent->bUseSeparateBrakingFriction = bUseSeparateBrakingFriction;
+
+	MovementComponent->GroundFriction = GroundFriction;
+	MovementComponent->MaxWalkSpeed = MaxWalkSpeed;
+	MovementComponent->MinAnalogWalkSpeed = MinAnalogWalkSpeed;
+	MovementComponent->BrakingDecelerationWalking = BrakingDecelerationWalking;
+	MovementComponent->SetWalkableFloorAngle(WalkableFloorAngle);
+	MovementComponent->PerchRadiusThreshold = PerchRadiusThreshold;
+	MovementComponent->LedgeCheckThreshold = LedgeCheckThreshold;
+	MovementComponent->bIgnoreBaseRotation = bIgnoreBaseRotation;
+
+	MovementComponent->JumpZVelocity = JumpZVelocity;
+	MovementComponent->BrakingDecelerationFalling = BrakingDecelerationFalling;
+	MovementComponent->AirControl = AirControl;
+
+	MovementComponent->RotationRate = RotationRate;
+	MovementComponent->bOrientRotationToMovement = bOrientRotationToMovement;
+}
+
+FCharacterMovementProfile FCharacterMovementProfile::CaptureFrom(const UCharacterMovementComponent* MovementComponent)
+{
+	check(MovementComponent);
+
+	FCharacterMovementProfile Profile;
+
+	Profile.GravityScale = MovementComponent->GravityScale;
+	Profile.MaxAcceleration = MovementComponent->MaxAcceleration;
+	Profile.Mass = MovementComponent->Mass;
+	Profile.BrakingFrictionFactor = MovementComponent->BrakingFrictionFactor;
+	Profile.bUseSeparateBrakingFriction = MovementComponent->bUseSeparateBrakingFriction;
+
+	Profile.GroundFriction = MovementComponent->GroundFriction;
+	Profile.MaxWalkSpeed = MovementComponent->MaxWalkSpeed;
+	Profile.MinAnalogWalkSpeed = MovementComponent->MinAnalogWalkSpeed;
+	Profile.BrakingDecelerationWalking = MovementComponent->BrakingDecelerationWalking;
+	Profile.WalkableFloorAngle = MovementComponent->GetWalkableFloorAngle();
+	Profile.PerchRadiusThreshold = MovementComponent->PerchRadiusThreshold;
+	Profile.LedgeCheckThreshold = MovementComponent->LedgeCheckThreshold;
+	Profile.bIgnoreBaseRotation = MovementComponent->bIgnoreBaseRotation;
+
+	Profile.JumpZVelocity = MovementComponent->JumpZVelocity;
+	Profile.BrakingDecelerationFalling = MovementComponent->BrakingDecelerationFalling;
+	Profile.AirControl = MovementComponent->AirControl;
+
+	Profile.RotationRate = MovementComponent->RotationRate;
+	Profile.bOrientRotationToMovement = MovementComponent->bOrientRotationToMovement;
+
+	return Profile;
+}
+
+#if WITH_EDITOR
+EDataValidationResult UCharacterMovementProfileAsset::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	// a walking character with no speed or acceleration can't move
+	if (Profile.MaxWalkSpeed <= 0.0f || Profile.MaxAcceleration <= 0.0f)
+	{
+		Context.AddWarning(LOCTEXT("NoGroundMovement", "MaxWalkSpeed and MaxAcceleration should be greater than zero, or the character won't be able to walk."));
+	}
+
+	// analog input can't be faster than the max speed
+	if (Profile.MinAnalogWalkSpeed > Profile.MaxWalkSpeed)
+	{
+		Context.AddError(LOCTEXT("AnalogSpeedTooHigh", "MinAnalogWalkSpeed must not exceed MaxWalkSpeed."));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	// perching is tested against the capsule radius, so negative values are meaningless
+	if (Profile.PerchRadiusThreshold < 0.0f || Profile.LedgeCheckThreshold < 0.0f)
+	{
+		Context.AddError(LOCTEXT("NegativeThreshold", "PerchRadiusThreshold and LedgeCheckThreshold must not be negative."));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	// air control is a fraction of the ground acceleration
+	if (Profile.AirControl < 0.0f || Profile.AirControl > 1.0f)
+	{
+		Context.AddError(LOCTEXT("AirControlRange", "AirControl must be between 0 and 1."));
+		Result = EDataValidationResult::Invalid;
+	}
+
+	return Result;
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
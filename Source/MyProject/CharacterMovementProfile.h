@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CharacterMovementProfile.generated.h"
+
+class UCharacterMovementComponent;
+
+/**
+ *  Flat set of Character Movement Component tunables.
+ *  Lets characters swap between movement states (e.g. walking, dashing) by applying a whole profile at once,
+ *  instead of writing individual fields. Defaults match the engine defaults.
+ */
+USTRUCT(BlueprintType)
+struct FCharacterMovementProfile
+{
+	GENERATED_BODY()
+
+	/** Gravity multiplier */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="General", meta=(ClampMin=0, ClampMax=10))
+	float GravityScale = 1.0f;
+
+	/** Max acceleration */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="General", meta=(ClampMin=0, ClampMax=10000, Units="cm/s^2"))
+	float MaxAcceleration = 2048.0f;
+
+	/** Mass of the pawn, used when pushing physics objects */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="General", meta=(ClampMin=0, ClampMax=10000, Units="kg"))
+	float Mass = 100.0f;
+
+	/** Friction multiplier applied when braking */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="General", meta=(ClampMin=0, ClampMax=10))
+	float BrakingFrictionFactor = 2.0f;
+
+	/** If true, BrakingFriction is used instead of GroundFriction when braking */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="General")
+	bool bUseSeparateBrakingFriction = false;
+
+	/** Ground friction */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking", meta=(ClampMin=0, ClampMax=100))
+	float GroundFriction = 8.0f;
+
+	/** Max ground speed */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking", meta=(ClampMin=0, ClampMax=10000, Units="cm/s"))
+	float MaxWalkSpeed = 600.0f;
+
+	/** Min ground speed with analog input */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking", meta=(ClampMin=0, ClampMax=10000, Units="cm/s"))
+	float MinAnalogWalkSpeed = 0.0f;
+
+	/** Deceleration when walking without acceleration */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking", meta=(ClampMin=0, ClampMax=10000, Units="cm/s^2"))
+	float BrakingDecelerationWalking = 2048.0f;
+
+	/** Max walkable floor angle */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking", meta=(ClampMin=0, ClampMax=90, Units="deg"))
+	float WalkableFloorAngle = 44.765368f;
+
+	/** Don't allow the character to perch on the edge of a surface if the contact is this close to the edge of the capsule */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking", meta=(ClampMin=0, ClampMax=100, Units="cm"))
+	float PerchRadiusThreshold = 0.0f;
+
+	/** Used when checking if the character is stepping off a ledge */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking", meta=(ClampMin=0, ClampMax=100, Units="cm"))
+	float LedgeCheckThreshold = 4.0f;
+
+	/** If true, the character ignores the rotation of the base it's standing on */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Walking")
+	bool bIgnoreBaseRotation = false;
+
+	/** Initial vertical velocity when jumping */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Jumping / Falling", meta=(ClampMin=0, ClampMax=10000, Units="cm/s"))
+	float JumpZVelocity = 420.0f;
+
+	/** Lateral deceleration when falling without acceleration */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Jumping / Falling", meta=(ClampMin=0, ClampMax=10000, Units="cm/s^2"))
+	float BrakingDecelerationFalling = 0.0f;
+
+	/** Amount of lateral control available while falling */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Jumping / Falling", meta=(ClampMin=0, ClampMax=1))
+	float AirControl = 0.05f;
+
+	/** Rotation speed when orienting to movement */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Rotation")
+	FRotator RotationRate = FRotator(0.0f, 360.0f, 0.0f);
+
+	/** If true, rotates the character towards the direction of acceleration */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Rotation")
+	bool bOrientRotationToMovement = false;
+
+	/** Copies all values in this profile onto the provided movement component */
+	void ApplyTo(UCharacterMovementComponent* MovementComponent) const;
+
+	/** Builds a profile from the current values of the provided movement component */
+	static FCharacterMovementProfile CaptureFrom(const UCharacterMovementComponent* MovementComponent);
+};
+
+/**
+ *  Data asset wrapping a Character Movement Profile, so movement tuning can be authored and shared outside of code
+ */
+UCLASS(BlueprintType)
+class UCharacterMovementProfileAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Movement values to apply */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Movement", meta=(ShowOnlyInnerProperties))
+	FCharacterMovementProfile Profile;
+
+#if WITH_EDITOR
+	/** Validates the profile values */
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+};
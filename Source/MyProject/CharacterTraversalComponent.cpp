@@ -0,0 +1,269 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CharacterTraversalComponent.h"
+#include "InputBufferComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+#include "MyProject.h"
+
+/** Name of the jump action in the owner's input buffer */
+static const FName JumpInputName(TEXT("Jump"));
+
+UCharacterTraversalComponent::UCharacterTraversalComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+
+	// initialize the flags
+	bWallInRange = false;
+	bHasWallJumped = false;
+	bHasDoubleJumped = false;
+	bVerifyBufferedJump = false;
+
+	// bind the wall probe delegate
+	WallProbeDelegate.BindUObject(this, &UCharacterTraversalComponent::OnWallProbeComplete);
+}
+
+void UCharacterTraversalComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// cache the owning character
+	OwnerCharacter = Cast<ACharacter>(GetOwner());
+
+	// we only work with characters
+	if (!OwnerCharacter)
+	{
+		UE_LOG(LogMyProject, Error, TEXT("Character Traversal Component on %s requires a Character owner."), *GetNameSafe(GetOwner()));
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	// find the input buffer to hold jumps we can't use right away
+	InputBuffer = OwnerCharacter->FindComponentByClass<UInputBufferComponent>();
+
+	if (!InputBuffer)
+	{
+		UE_LOG(LogMyProject, Warning, TEXT("Character Traversal Component on %s has no Input Buffer Component to use. Jump buffering is disabled."), *GetNameSafe(OwnerCharacter));
+	}
+
+	// tick after movement, so we probe from the updated location and can see jumps the CMC performed this frame
+	AddTickPrerequisiteComponent(OwnerCharacter->GetCharacterMovement());
+}
+
+void UCharacterTraversalComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// cancel the wall jump reset timer
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->CancelAll(this);
+	}
+}
+
+void UCharacterTraversalComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// the CMC should have performed the buffered jump we replayed last frame
+	if (bVerifyBufferedJump)
+	{
+		bVerifyBufferedJump = false;
+
+		if (OwnerCharacter->JumpCurrentCount == 0 && !OwnerCharacter->GetCharacterMovement()->IsFalling())
+		{
+			UE_LOG(LogMyProject, Warning, TEXT("Buffered jump on %s was not performed."), *GetNameSafe(OwnerCharacter));
+		}
+	}
+
+	// we only need to look for walls if we're airborne and able to wall jump
+	if (!OwnerCharacter->GetCharacterMovement()->IsFalling() || bHasWallJumped)
+	{
+		bWallInRange = false;
+		WallProbeHandle = FTraceHandle();
+		return;
+	}
+
+	// find the probe direction
+	const bool bHasProbeDirection = !WallProbeDirection.IsNearlyZero();
+
+	if (!bHasProbeDirection && !bProbeAlongOwnerForward)
+	{
+		bWallInRange = false;
+		WallProbeHandle = FTraceHandle();
+		return;
+	}
+
+	const FVector ProbeDirection = bHasProbeDirection ? WallProbeDirection : OwnerCharacter->GetActorForwardVector();
+
+	const FVector TraceStart = OwnerCharacter->GetActorLocation();
+	const FVector TraceEnd = TraceStart + (ProbeDirection * WallProbeDistance);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TraversalWallProbe));
+	QueryParams.AddIgnoredActor(OwnerCharacter);
+
+	// issue the probe. The result will be available by the time we receive jump inputs next frame
+	if (WallProbeRadius > 0.0f)
+	{
+		WallProbeHandle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, FQuat::Identity, WallProbeChannel, FCollisionShape::MakeSphere(WallProbeRadius), QueryParams, FCollisionResponseParams::DefaultResponseParam, &WallProbeDelegate);
+
+	} else {
+
+		WallProbeHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, WallProbeChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam, &WallProbeDelegate);
+	}
+}
+
+void UCharacterTraversalComponent::OnWallProbeComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceData)
+{
+	// ignore results from probes we no longer care about
+	if (TraceHandle != WallProbeHandle)
+	{
+		return;
+	}
+
+	// save the wall hit, if any
+	bWallInRange = TraceData.OutHits.Num() > 0 && TraceData.OutHits[0].bBlockingHit;
+
+	if (bWallInRange)
+	{
+		WallHit = TraceData.OutHits[0];
+	}
+}
+
+ETraversalJumpType UCharacterTraversalComponent::TryJump()
+{
+	if (!OwnerCharacter)
+	{
+		return ETraversalJumpType::None;
+	}
+
+	// we're grounded so just do a regular jump
+	if (!OwnerCharacter->GetCharacterMovement()->IsFalling())
+	{
+		DoJump(ETraversalJumpType::Ground);
+		return ETraversalJumpType::Ground;
+	}
+
+	// ignore jumps while locked out from a wall jump
+	if (!bHasWallJumped)
+	{
+		// did the last probe find a wall?
+		if (bWallInRange)
+		{
+			DoWallJump();
+			return ETraversalJumpType::Wall;
+		}
+
+		// are we still within coyote time frames?
+		if (GetWorld()->GetTimeSeconds() - LastFallTime < MaxCoyoteTime)
+		{
+			UE_LOG(LogMyProject, Verbose, TEXT("Coyote Jump"));
+
+			DoJump(ETraversalJumpType::Coyote);
+			return ETraversalJumpType::Coyote;
+		}
+
+		// only double jump once while we're in the air
+		if (!bHasDoubleJumped)
+		{
+			bHasDoubleJumped = true;
+
+			DoJump(ETraversalJumpType::Double);
+			return ETraversalJumpType::Double;
+		}
+	}
+
+	// we couldn't use the jump, so buffer it in case we land soon
+	if (InputBuffer)
+	{
+		InputBuffer->BufferInput(JumpInputName);
+	}
+
+	return ETraversalJumpType::None;
+}
+
+void UCharacterTraversalComponent::SetWallProbeDirection(const FVector& Direction)
+{
+	WallProbeDirection = Direction.GetSafeNormal();
+}
+
+void UCharacterTraversalComponent::HandleLanded()
+{
+	// reset the double jump
+	bHasDoubleJumped = false;
+}
+
+void UCharacterTraversalComponent::HandleMovementModeChanged()
+{
+	if (!OwnerCharacter)
+	{
+		return;
+	}
+
+	UCharacterMovementComponent* Movement = OwnerCharacter->GetCharacterMovement();
+
+	// are we falling?
+	if (Movement->MovementMode == EMovementMode::MOVE_Falling)
+	{
+		// save the game time when we started falling, so we can check it later for coyote time jumps
+		LastFallTime = GetWorld()->GetTimeSeconds();
+
+	} else if (Movement->IsMovingOnGround() && InputBuffer) {
+
+		// replay the buffered jump if it's recent enough. ACharacter has already reset the jump state for the landing,
+		// so the jump press survives until the CMC checks for jump input next tick
+		if (InputBuffer->ConsumeInput(JumpInputName, JumpBufferTime))
+		{
+			UE_LOG(LogMyProject, Verbose, TEXT("Buffered Jump"));
+
+			DoJump(ETraversalJumpType::Buffered);
+
+			bVerifyBufferedJump = true;
+		}
+
+		// any stale jumps shouldn't carry over to the next landing
+		InputBuffer->ClearInput(JumpInputName);
+	}
+}
+
+void UCharacterTraversalComponent::DoWallJump()
+{
+	// rotate the character to face away from the wall, so we're correctly oriented for the next wall jump
+	const FRotator WallOrientation = WallHit.ImpactNormal.ToOrientationRotator();
+	OwnerCharacter->SetActorRotation(FRotator(0.0f, WallOrientation.Yaw, 0.0f));
+
+	// apply a launch impulse to the character to perform the actual wall jump
+	const FVector WallJumpImpulse = (WallHit.ImpactNormal * WallJumpHorizontalImpulse) + (FVector::UpVector * WallJumpVerticalImpulse);
+
+	OwnerCharacter->LaunchCharacter(WallJumpImpulse, true, true);
+
+	// raise the wall jump flag to prevent an immediate second wall jump
+	bHasWallJumped = true;
+	bWallInRange = false;
+
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Reschedule(WallJumpTimer, this, DelayBetweenWallJumps, &UCharacterTraversalComponent::ResetWallJump);
+	}
+
+	// notify listeners
+	OnTraversalJump.Broadcast(ETraversalJumpType::Wall);
+}
+
+void UCharacterTraversalComponent::DoJump(ETraversalJumpType JumpType)
+{
+	// use the built-in CMC functionality to do the jump
+	OwnerCharacter->Jump();
+
+	// notify listeners
+	OnTraversalJump.Broadcast(JumpType);
+}
+
+void UCharacterTraversalComponent::ResetWallJump()
+{
+	// reset the wall jump input lock
+	bHasWallJumped = false;
+}
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/HitResult.h"
+#include "WorldCollision.h"
+#include "GameplaySchedulerSubsystem.h"
+#include "CharacterTraversalComponent.generated.h"
+
+class ACharacter;
+class UInputBufferComponent;
+
+/** Types of jumps performed by the traversal component */
+UENUM(BlueprintType)
+enum class ETraversalJumpType : uint8
+{
+	None,
+	Ground,
+	Coyote,
+	Double,
+	Wall,
+	Buffered
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTraversalJump, ETraversalJumpType /* JumpType */);
+
+/**
+ *  Shared advanced jump logic for player characters:
+ *  - Wall Jump
+ *  - Coyote Time
+ *  - Double Jump
+ *  - Jump Buffering
+ *  Wall probes are issued as async traces every frame while airborne, so the
+ *  jump input only needs to read the latest result.
+ *  The owning character must set JumpMaxCount high enough to allow coyote and double jumps.
+ *  Jump buffering requires an Input Buffer Component on the owner, so jumps share the same buffer as other actions.
+ *  Characters that expose their own wall jump tuning pass it to the component on BeginPlay.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class UCharacterTraversalComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Distance to probe ahead of the character to look for walls to jump from */
+	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
+	float WallProbeDistance = 50.0f;
+
+	/** Radius of the wall probe sweep. A radius of zero runs a line trace instead */
+	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 100, Units = "cm"))
+	float WallProbeRadius = 25.0f;
+
+	/** If true, walls are probed along the owner's forward vector while no probe direction is set. Otherwise no probe runs */
+	UPROPERTY(EditAnywhere, Category="Wall Jump")
+	bool bProbeAlongOwnerForward = true;
+
+	/** Trace channel to use for wall probes */
+	UPROPERTY(EditAnywhere, Category="Wall Jump")
+	TEnumAsByte<ECollisionChannel> WallProbeChannel = ECC_Visibility;
+
+	/** Impulse to apply away from the wall when wall jumping */
+	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
+	float WallJumpHorizontalImpulse = 800.0f;
+
+	/** Vertical impulse to apply when wall jumping */
+	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
+	float WallJumpVerticalImpulse = 900.0f;
+
+	/** Time to ignore jump inputs after a wall jump */
+	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float DelayBetweenWallJumps = 0.1f;
+
+	/** Max amount of time that can pass since we started falling when we allow a regular jump */
+	UPROPERTY(EditAnywhere, Category="Coyote Time", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
+	float MaxCoyoteTime = 0.16f;
+
+	/** Jump inputs that can't be used in the air are replayed if we land within this time */
+	UPROPERTY(EditAnywhere, Category="Jump Buffer", meta = (ClampMin = 0, ClampMax = 1, Units = "s"))
+	float JumpBufferTime = 0.1f;
+
+	/** Called whenever the component performs a jump */
+	FOnTraversalJump OnTraversalJump;
+
+protected:
+
+	/** Owning character */
+	UPROPERTY()
+	ACharacter* OwnerCharacter;
+
+	/** Owner's input buffer, used to hold jump inputs that couldn't be used in the air */
+	UPROPERTY()
+	UInputBufferComponent* InputBuffer;
+
+	/** Direction to probe for walls. If zero, the owner's forward vector is used if allowed */
+	FVector WallProbeDirection = FVector::ZeroVector;
+
+	/** Most recent blocking hit from the wall probe */
+	FHitResult WallHit;
+
+	/** Handle of the last issued wall probe, so stale results can be discarded */
+	FTraceHandle WallProbeHandle;
+
+	/** Delegate called when the wall probe completes */
+	FTraceDelegate WallProbeDelegate;
+
+	/** Timer for wall jump input reset */
+	FGameplayScheduleHandle WallJumpTimer;
+
+	/** Last recorded time when the character started falling */
+	float LastFallTime = 0.0f;
+
+	/** traversal state flag bits */
+	uint8 bWallInRange : 1;
+	uint8 bHasWallJumped : 1;
+	uint8 bHasDoubleJumped : 1;
+	uint8 bVerifyBufferedJump : 1;
+
+public:
+
+	/** Constructor */
+	UCharacterTraversalComponent();
+
+protected:
+
+	/** Initialization */
+	virtual void BeginPlay() override;
+
+	/** Cleanup */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Issues the async wall probe for the next jump input */
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Attempts the best available jump, returns the type of jump performed */
+	ETraversalJumpType TryJump();
+
+	/** Sets the direction to probe for walls. Pass a zero vector to fall back to the owner's forward vector, or to stop probing */
+	void SetWallProbeDirection(const FVector& Direction);
+
+	/** Resets the double jump. Must be called from the owner's Landed */
+	void HandleLanded();
+
+	/**
+	 *  Keeps track of coyote time and replays any buffered jump once we're walking.
+	 *  Must be called from the owner's OnMovementModeChanged, after calling Super,
+	 *  since ACharacter resets the jump state when landing.
+	 */
+	void HandleMovementModeChanged();
+
+	/** Returns true if the character has just double jumped */
+	bool HasDoubleJumped() const { return bHasDoubleJumped; }
+
+	/** Returns true if the character has just wall jumped, and is locked out of movement input */
+	bool HasWallJumped() const { return bHasWallJumped; }
+
+protected:
+
+	/** Launches the character away from the last probed wall */
+	void DoWallJump();
+
+	/** Performs a regular CMC jump and notifies listeners */
+	void DoJump(ETraversalJumpType JumpType);
+
+	/** Resets the wall jump input lock */
+	void ResetWallJump();
+
+	/** Handles the wall probe result */
+	void OnWallProbeComplete(const FTraceHandle& TraceHandle, FTraceDatum& TraceData);
+};
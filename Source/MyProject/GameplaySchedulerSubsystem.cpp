@@ -0,0 +1,333 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "GameplaySchedulerSubsystem.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("GameplayScheduler"), STATGROUP_GameplayScheduler, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Scheduler Tick"), STAT_GameplaySchedulerTick, STATGROUP_GameplayScheduler);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Callbacks Fired"), STAT_GameplaySchedulerCallbacksFired, STATGROUP_GameplayScheduler);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Calls"), STAT_GameplaySchedulerPendingCalls, STATGROUP_GameplayScheduler);
+
+UGameplaySchedulerSubsystem::UGameplaySchedulerSubsystem()
+{
+	for (int32& Head : BucketHeads)
+	{
+		Head = INDEX_NONE;
+	}
+}
+
+FGameplayScheduleHandle UGameplaySchedulerSubsystem::Schedule(const UObject* Owner, float Delay, TFunction<void()>&& Callback)
+{
+	if (!ensure(Owner) || !Callback)
+	{
+		return FGameplayScheduleHandle();
+	}
+
+	// reuse a free slot if we have one
+	int32 Index;
+
+	if (FreeSlots.Num() > 0)
+	{
+		Index = FreeSlots.Pop(EAllowShrinking::No);
+
+	} else {
+
+		Index = Calls.AddDefaulted();
+	}
+
+	FScheduledCall& Call = Calls[Index];
+	Call.Callback = MoveTemp(Callback);
+	Call.Owner = Owner;
+	Call.bScheduled = true;
+
+	// round the due time up to the wheel resolution, and never fire on the tick we're already on
+	const uint64 DueTick = static_cast<uint64>(FMath::CeilToDouble((ElapsedTime + FMath::Max(Delay, 0.0f)) / TickResolution));
+	Call.DueTick = FMath::Max(DueTick, CurrentTick + 1);
+
+	LinkCall(Index);
+
+	OwnerCalls.FindOrAdd(Call.Owner).Add(Index);
+	++NumScheduled;
+
+	FGameplayScheduleHandle Handle;
+	Handle.Index = Index;
+	Handle.Serial = Call.Serial;
+
+	return Handle;
+}
+
+bool UGameplaySchedulerSubsystem::Cancel(FGameplayScheduleHandle& Handle)
+{
+	const bool bWasScheduled = FindCall(Handle) != nullptr;
+
+	if (bWasScheduled)
+	{
+		ReleaseCall(Handle.Index);
+	}
+
+	Handle.Invalidate();
+
+	return bWasScheduled;
+}
+
+void UGameplaySchedulerSubsystem::CancelAll(const UObject* Owner)
+{
+	const TObjectKey<UObject> OwnerKey(Owner);
+
+	// take the owner's list out first, since releasing calls updates it
+	TArray<int32, TInlineAllocator<2>> OwnedCalls;
+
+	if (!OwnerCalls.RemoveAndCopyValue(OwnerKey, OwnedCalls))
+	{
+		return;
+	}
+
+	for (int32 Index : OwnedCalls)
+	{
+		ReleaseCall(Index);
+	}
+}
+
+bool UGameplaySchedulerSubsystem::IsScheduled(const FGameplayScheduleHandle& Handle) const
+{
+	return FindCall(Handle) != nullptr;
+}
+
+float UGameplaySchedulerSubsystem::GetTimeRemaining(const FGameplayScheduleHandle& Handle) const
+{
+	if (const FScheduledCall* Call = FindCall(Handle))
+	{
+		return static_cast<float>(FMath::Max(Call->DueTick * TickResolution - ElapsedTime, 0.0));
+	}
+
+	return -1.0f;
+}
+
+const UGameplaySchedulerSubsystem::FScheduledCall* UGameplaySchedulerSubsystem::FindCall(const FGameplayScheduleHandle& Handle) const
+{
+	if (!Calls.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	const FScheduledCall& Call = Calls[Handle.Index];
+
+	return (Call.bScheduled && Call.Serial == Handle.Serial) ? &Call : nullptr;
+}
+
+void UGameplaySchedulerSubsystem::LinkCall(int32 Index)
+{
+	FScheduledCall& Call = Calls[Index];
+
+	// find the lowest level whose range covers the delay
+	const uint64 Delta = Call.DueTick > CurrentTick ? Call.DueTick - CurrentTick : 0;
+	uint64 BucketTick = FMath::Max(Call.DueTick, CurrentTick);
+	int32 Level = 0;
+
+	while (Level < NumLevels - 1 && Delta >= (uint64(1) << ((Level + 1) * WheelBits)))
+	{
+		++Level;
+	}
+
+	// calls beyond the wheel range go in the furthest bucket and get re-linked when it cascades
+	const uint64 MaxDelta = (uint64(1) << (NumLevels * WheelBits)) - 1;
+
+	if (Delta > MaxDelta)
+	{
+		BucketTick = CurrentTick + MaxDelta;
+	}
+
+	const int32 Bucket = Level * WheelSize + static_cast<int32>((BucketTick >> (Level * WheelBits)) & (WheelSize - 1));
+
+	// push to the front of the bucket list
+	Call.Bucket = Bucket;
+	Call.Prev = INDEX_NONE;
+	Call.Next = BucketHeads[Bucket];
+
+	if (Call.Next != INDEX_NONE)
+	{
+		Calls[Call.Next].Prev = Index;
+	}
+
+	BucketHeads[Bucket] = Index;
+}
+
+void UGameplaySchedulerSubsystem::UnlinkCall(int32 Index)
+{
+	FScheduledCall& Call = Calls[Index];
+
+	if (Call.Bucket == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Call.Prev != INDEX_NONE)
+	{
+		Calls[Call.Prev].Next = Call.Next;
+
+	} else {
+
+		BucketHeads[Call.Bucket] = Call.Next;
+	}
+
+	if (Call.Next != INDEX_NONE)
+	{
+		Calls[Call.Next].Prev = Call.Prev;
+	}
+
+	Call.Prev = Call.Next = Call.Bucket = INDEX_NONE;
+}
+
+void UGameplaySchedulerSubsystem::ReleaseCall(int32 Index)
+{
+	FScheduledCall& Call = Calls[Index];
+
+	if (!Call.bScheduled)
+	{
+		return;
+	}
+
+	UnlinkCall(Index);
+
+	// remove the call from its owner's list
+	if (TArray<int32, TInlineAllocator<2>>* OwnedCalls = OwnerCalls.Find(Call.Owner))
+	{
+		OwnedCalls->RemoveSingleSwap(Index, EAllowShrinking::No);
+
+		if (OwnedCalls->IsEmpty())
+		{
+			OwnerCalls.Remove(Call.Owner);
+		}
+	}
+
+	// invalidate outstanding handles and free the slot
+	Call.Callback.Reset();
+	Call.Owner = TObjectKey<UObject>();
+	Call.bScheduled = false;
+	++Call.Serial;
+
+	FreeSlots.Add(Index);
+	--NumScheduled;
+}
+
+void UGameplaySchedulerSubsystem::CascadeBucket(int32 Level, int32 BucketIndex)
+{
+	const int32 Bucket = Level * WheelSize + BucketIndex;
+
+	// detach the whole list, then re-link each call relative to the current tick
+	int32 Index = BucketHeads[Bucket];
+	BucketHeads[Bucket] = INDEX_NONE;
+
+	while (Index != INDEX_NONE)
+	{
+		const int32 Next = Calls[Index].Next;
+
+		Calls[Index].Bucket = INDEX_NONE;
+		LinkCall(Index);
+
+		Index = Next;
+	}
+}
+
+int32 UGameplaySchedulerSubsystem::AdvanceTick()
+{
+	++CurrentTick;
+
+	// when a level wraps around, move the next bucket of the level above down
+	for (int32 Level = 1; Level < NumLevels; ++Level)
+	{
+		const uint64 LowerMask = (uint64(1) << (Level * WheelBits)) - 1;
+
+		if ((CurrentTick & LowerMask) != 0)
+		{
+			break;
+		}
+
+		CascadeBucket(Level, static_cast<int32>((CurrentTick >> (Level * WheelBits)) & (WheelSize - 1)));
+	}
+
+	// gather the due calls first, since callbacks may schedule or cancel other calls
+	const int32 Bucket = static_cast<int32>(CurrentTick & (WheelSize - 1));
+
+	FiringCalls.Reset();
+
+	for (int32 Index = BucketHeads[Bucket]; Index != INDEX_NONE; Index = Calls[Index].Next)
+	{
+		FiringCalls.Emplace(Index, Calls[Index].Serial);
+	}
+
+	int32 NumFired = 0;
+
+	for (const TPair<int32, uint32>& Firing : FiringCalls)
+	{
+		FScheduledCall& Call = Calls[Firing.Key];
+
+		// skip calls cancelled by an earlier callback this tick
+		if (!Call.bScheduled || Call.Serial != Firing.Value)
+		{
+			continue;
+		}
+
+		// release the slot before running the callback so it can reschedule freely
+		TFunction<void()> Callback = MoveTemp(Call.Callback);
+		const bool bOwnerAlive = Call.Owner.ResolveObjectPtr() != nullptr;
+
+		ReleaseCall(Firing.Key);
+
+		if (bOwnerAlive)
+		{
+			Callback();
+			++NumFired;
+		}
+	}
+
+	return NumFired;
+}
+
+void UGameplaySchedulerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GameplaySchedulerTick);
+
+	Super::Tick(DeltaTime);
+
+	ElapsedTime += DeltaTime;
+
+	const uint64 TargetTick = static_cast<uint64>(FMath::FloorToDouble(ElapsedTime / TickResolution));
+	int32 NumFired = 0;
+
+	while (CurrentTick < TargetTick)
+	{
+		// nothing pending, so there's nothing to cascade or fire
+		if (NumScheduled == 0)
+		{
+			CurrentTick = TargetTick;
+			break;
+		}
+
+		NumFired += AdvanceTick();
+	}
+
+	INC_DWORD_STAT_BY(STAT_GameplaySchedulerCallbacksFired, NumFired);
+	SET_DWORD_STAT(STAT_GameplaySchedulerPendingCalls, NumScheduled);
+}
+
+TStatId UGameplaySchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGameplaySchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UGameplaySchedulerSubsystem::Deinitialize()
+{
+	Calls.Empty();
+	FreeSlots.Empty();
+	OwnerCalls.Empty();
+	NumScheduled = 0;
+
+	for (int32& Head : BucketHeads)
+	{
+		Head = INDEX_NONE;
+	}
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GameplaySchedulerSubsystem.generated.h"
+
+/** Identifies a callback scheduled with the gameplay scheduler */
+struct FGameplayScheduleHandle
+{
+	/** Index of the scheduled call slot */
+	int32 Index = INDEX_NONE;
+
+	/** Serial of the slot when the call was scheduled. Stale handles won't match */
+	uint32 Serial = 0;
+
+	/** Returns true if this handle was ever set. The call may have fired since */
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	/** Clears the handle */
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+/**
+ *  Lightweight per-world scheduler for delayed gameplay callbacks, such as respawns and death cleanup.
+ *  Calls are stored in a hierarchical timing wheel, so scheduling and cancelling are O(1)
+ *  and each frame only touches the buckets that are due.
+ *  Calls are owned by an object, and all calls for an owner can be cancelled at once.
+ *  Like the timer manager, it runs on dilated world time and stops while the game is paused.
+ *  Use "stat GameplayScheduler" to see the number of callbacks fired each frame.
+ */
+UCLASS()
+class UGameplaySchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Number of bits for the bucket index on each wheel level */
+	static constexpr int32 WheelBits = 6;
+
+	/** Number of buckets on each wheel level */
+	static constexpr int32 WheelSize = 1 << WheelBits;
+
+	/** Number of wheel levels. Covers WheelSize ^ NumLevels ticks */
+	static constexpr int32 NumLevels = 4;
+
+	/** A single scheduled call */
+	struct FScheduledCall
+	{
+		/** Callback to run */
+		TFunction<void()> Callback;
+
+		/** Object owning the call. The call is skipped if the owner is gone */
+		TObjectKey<UObject> Owner;
+
+		/** Wheel tick the call is due on */
+		uint64 DueTick = 0;
+
+		/** Incremented every time the slot is released, to invalidate old handles */
+		uint32 Serial = 1;
+
+		/** Intrusive bucket list links */
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+
+		/** Bucket the call is linked into, or INDEX_NONE */
+		int32 Bucket = INDEX_NONE;
+
+		/** True while the slot holds a pending call */
+		bool bScheduled = false;
+	};
+
+	/** Scheduled call slots */
+	TArray<FScheduledCall> Calls;
+
+	/** Released slots available for reuse */
+	TArray<int32> FreeSlots;
+
+	/** Head slot of each wheel bucket, NumLevels * WheelSize entries */
+	int32 BucketHeads[NumLevels * WheelSize];
+
+	/** Pending call slots for each owner */
+	TMap<TObjectKey<UObject>, TArray<int32, TInlineAllocator<2>>> OwnerCalls;
+
+	/** Wheel tick we've advanced to */
+	uint64 CurrentTick = 0;
+
+	/** Scheduler time accumulated from dilated world deltas */
+	double ElapsedTime = 0.0;
+
+	/** Number of pending calls */
+	int32 NumScheduled = 0;
+
+	/** Slots being fired this wheel tick, reused to avoid allocations */
+	TArray<TPair<int32, uint32>> FiringCalls;
+
+public:
+
+	/** Wheel resolution. Delays are rounded up to a multiple of this */
+	static constexpr double TickResolution = 0.01;
+
+	/** Constructor */
+	UGameplaySchedulerSubsystem();
+
+	/** Schedules a callback to run once after the delay. The callback is skipped if the owner is destroyed first */
+	FGameplayScheduleHandle Schedule(const UObject* Owner, float Delay, TFunction<void()>&& Callback);
+
+	/** Schedules a member function to run once after the delay */
+	template<typename UserClass>
+	FGameplayScheduleHandle Schedule(UserClass* Owner, float Delay, void (UserClass::*Func)())
+	{
+		return Schedule(Owner, Delay, [Owner, Func]() { (Owner->*Func)(); });
+	}
+
+	/** Cancels the pending call in the handle, if any, and schedules a new one in its place. Mirrors FTimerManager::SetTimer */
+	template<typename UserClass>
+	void Reschedule(FGameplayScheduleHandle& Handle, UserClass* Owner, float Delay, void (UserClass::*Func)())
+	{
+		Cancel(Handle);
+		Handle = Schedule(Owner, Delay, Func);
+	}
+
+	/** Cancels the scheduled call and invalidates the handle. Returns true if the call was still pending */
+	bool Cancel(FGameplayScheduleHandle& Handle);
+
+	/** Cancels all pending calls for the owner */
+	void CancelAll(const UObject* Owner);
+
+	/** Returns true if the call is still pending */
+	bool IsScheduled(const FGameplayScheduleHandle& Handle) const;
+
+	/** Returns the time left until the call fires, or -1 if it isn't pending */
+	float GetTimeRemaining(const FGameplayScheduleHandle& Handle) const;
+
+	/** Returns the number of pending calls */
+	int32 GetNumScheduled() const { return NumScheduled; }
+
+protected:
+
+	/** Returns the pending call for the handle, or nullptr */
+	const FScheduledCall* FindCall(const FGameplayScheduleHandle& Handle) const;
+
+	/** Links the call into the wheel bucket matching its due tick */
+	void LinkCall(int32 Index);
+
+	/** Unlinks the call from its wheel bucket */
+	void UnlinkCall(int32 Index);
+
+	/** Unlinks and frees the slot, invalidating any handles to it */
+	void ReleaseCall(int32 Index);
+
+	/** Moves all calls in a bucket of a higher level down to their lower level buckets */
+	void CascadeBucket(int32 Level, int32 BucketIndex);
+
+	/** Advances the wheel by a single tick and fires the due calls. Returns the number of calls fired */
+	int32 AdvanceTick();
+
+public:
+
+	/** Advances the wheel and fires due calls */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+};
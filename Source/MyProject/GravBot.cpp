@@ -2,6 +2,7 @@
 
 
 #include "GravBot.h"
+#include "CharacterMovementProfile.h"
 #include "Engine/LocalPlayer.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -26,11 +27,13 @@ AGravBot::AGravBot()
 
 	// Note: For faster iteration times these variables, and many more, can be tweaked in the Character Blueprint
 	// instead of recompiling to adjust them
-	GetCharacterMovement()->JumpZVelocity = 500.f;
-	GetCharacterMovement()->AirControl = 0.35f;
-	GetCharacterMovement()->MinAnalogWalkSpeed = 20.f;
-	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
-	GetCharacterMovement()->BrakingDecelerationFalling = 1500.0f;
+	FCharacterMovementProfile DefaultMovementProfile;
+	DefaultMovementProfile.JumpZVelocity = 500.f;
+	DefaultMovementProfile.AirControl = 0.35f;
+	DefaultMovementProfile.MinAnalogWalkSpeed = 20.f;
+	DefaultMovementProfile.BrakingDecelerationWalking = 2000.f;
+	DefaultMovementProfile.BrakingDecelerationFalling = 1500.0f;
+	DefaultMovementProfile.ApplyTo(GetCharacterMovement());
 
 	// Create a camera boom (pulls in towards the player if there is a collision)
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
@@ -92,7 +95,12 @@ FVector AGravBot::ApplyFrictionToVector(FVector Value, float Friction, float Del
 void AGravBot::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	// Apply the movement profile override, if any. GravBot drives MaxWalkSpeed itself every tick
+	if (MovementProfile)
+	{
+		MovementProfile->Profile.ApplyTo(GetCharacterMovement());
+	}
 }
 // Getter and setter for CurrentVelocity
 FVector AGravBot::GetCurrentVelocity() const
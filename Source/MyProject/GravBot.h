@@ -10,6 +10,7 @@ class USpringArmComponent;
 class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
+class UCharacterMovementProfileAsset;
 
 UCLASS()
 class MYPROJECT_API AGravBot : public ACharacter
@@ -81,6 +82,10 @@ public:
 
 	bool isBraking;
 
+	/** Optional movement profile override. If unset, the character movement component values are used */
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	UCharacterMovementProfileAsset* MovementProfile;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -0,0 +1,170 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "InputBufferComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "MyProject.h"
+
+namespace InputBuffer
+{
+	/** Logs and optionally resets the input latency stats for every input buffer in the world */
+	static FAutoConsoleCommandWithWorldAndArgs DumpLatencyCommand(
+		TEXT("MyProject.InputBuffer.DumpLatency"),
+		TEXT("Logs input to action latency stats for every input buffer component. Pass 'reset' to clear the stats afterwards"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const bool bReset = Args.Num() > 0 && Args[0] == TEXT("reset");
+
+			for (TObjectIterator<UInputBufferComponent> It; It; ++It)
+			{
+				if (It->GetWorld() == World)
+				{
+					It->LogLatencyStats();
+
+					if (bReset)
+					{
+						It->ResetLatencyStats();
+					}
+				}
+			}
+		})
+	);
+}
+
+UInputBufferComponent::UInputBufferComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UInputBufferComponent::BufferInput(FName Action)
+{
+	FInputActionBuffer& Buffer = ActionBuffers.FindOrAdd(Action);
+
+	// write the event at the head of the ring, overwriting the oldest one if we're full
+	FBufferedInputEvent& Event = Buffer.Events[Buffer.Head];
+
+	Event.WorldTime = GetWorld()->GetTimeSeconds();
+	Event.PlatformTime = FPlatformTime::Seconds();
+	Event.Frame = GFrameCounter;
+	Event.bConsumed = false;
+
+	Buffer.Head = (Buffer.Head + 1) % FInputActionBuffer::Capacity;
+	Buffer.Num = FMath::Min(Buffer.Num + 1, FInputActionBuffer::Capacity);
+}
+
+bool UInputBufferComponent::HasBufferedInput(FName Action, float MaxAge) const
+{
+	const FInputActionBuffer* Buffer = ActionBuffers.Find(Action);
+
+	return Buffer && FindBufferedInput(*Buffer, MaxAge) != INDEX_NONE;
+}
+
+bool UInputBufferComponent::ConsumeInput(FName Action, float MaxAge)
+{
+	FInputActionBuffer* Buffer = ActionBuffers.Find(Action);
+
+	if (!Buffer)
+	{
+		return false;
+	}
+
+	const int32 EventIndex = FindBufferedInput(*Buffer, MaxAge);
+
+	if (EventIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// consume the input so it doesn't trigger twice
+	FBufferedInputEvent& Event = Buffer->Events[EventIndex];
+	Event.bConsumed = true;
+
+	// discard any older inputs, they've been superseded by this one
+	Buffer->Num = (Buffer->Head - EventIndex - 1 + FInputActionBuffer::Capacity) % FInputActionBuffer::Capacity;
+
+	// measure the input to action latency
+	const uint64 LatencyFrames = GFrameCounter - Event.Frame;
+	const double LatencyMs = (FPlatformTime::Seconds() - Event.PlatformTime) * 1000.0;
+
+	++Buffer->ConsumedCount;
+	Buffer->TotalLatencyFrames += LatencyFrames;
+	Buffer->MaxLatencyFrames = FMath::Max(Buffer->MaxLatencyFrames, LatencyFrames);
+	Buffer->TotalLatencyMs += LatencyMs;
+	Buffer->MaxLatencyMs = FMath::Max(Buffer->MaxLatencyMs, LatencyMs);
+
+	UE_LOG(LogMyProject, Verbose, TEXT("%s consumed %s input after %llu frames (%.2f ms)"), *GetNameSafe(GetOwner()), *Action.ToString(), LatencyFrames, LatencyMs);
+
+	return true;
+}
+
+void UInputBufferComponent::ClearInput(FName Action)
+{
+	if (FInputActionBuffer* Buffer = ActionBuffers.Find(Action))
+	{
+		Buffer->Head = 0;
+		Buffer->Num = 0;
+	}
+}
+
+void UInputBufferComponent::LogLatencyStats() const
+{
+	UE_LOG(LogMyProject, Display, TEXT("Input latency for %s:"), *GetNameSafe(GetOwner()));
+
+	for (const TPair<FName, FInputActionBuffer>& Pair : ActionBuffers)
+	{
+		const FInputActionBuffer& Buffer = Pair.Value;
+
+		if (Buffer.ConsumedCount == 0)
+		{
+			UE_LOG(LogMyProject, Display, TEXT("  %s: no consumed inputs"), *Pair.Key.ToString());
+			continue;
+		}
+
+		UE_LOG(LogMyProject, Display, TEXT("  %s: %d inputs, avg %.2f frames (%.2f ms), max %llu frames (%.2f ms)"),
+			*Pair.Key.ToString(),
+			Buffer.ConsumedCount,
+			double(Buffer.TotalLatencyFrames) / Buffer.ConsumedCount,
+			Buffer.TotalLatencyMs / Buffer.ConsumedCount,
+			Buffer.MaxLatencyFrames,
+			Buffer.MaxLatencyMs);
+	}
+}
+
+void UInputBufferComponent::ResetLatencyStats()
+{
+	for (TPair<FName, FInputActionBuffer>& Pair : ActionBuffers)
+	{
+		Pair.Value.ConsumedCount = 0;
+		Pair.Value.TotalLatencyFrames = 0;
+		Pair.Value.MaxLatencyFrames = 0;
+		Pair.Value.TotalLatencyMs = 0.0;
+		Pair.Value.MaxLatencyMs = 0.0;
+	}
+}
+
+int32 UInputBufferComponent::FindBufferedInput(const FInputActionBuffer& Buffer, float MaxAge) const
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	// walk the ring from the newest event to the oldest
+	for (int32 Offset = 1; Offset <= Buffer.Num; ++Offset)
+	{
+		const int32 Index = (Buffer.Head - Offset + FInputActionBuffer::Capacity) % FInputActionBuffer::Capacity;
+		const FBufferedInputEvent& Event = Buffer.Events[Index];
+
+		// events only get older from here, so stop once we're past the max age
+		if (CurrentTime - Event.WorldTime > MaxAge)
+		{
+			break;
+		}
+
+		if (!Event.bConsumed)
+		{
+			return Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputBufferComponent.generated.h"
+
+/** A single timestamped input event */
+struct FBufferedInputEvent
+{
+	/** World time when the input was received */
+	double WorldTime = 0.0;
+
+	/** Platform time when the input was received, used for latency measurement */
+	double PlatformTime = 0.0;
+
+	/** Frame number when the input was received */
+	uint64 Frame = 0;
+
+	/** Set once the input has been used by an action */
+	bool bConsumed = false;
+};
+
+/** Fixed capacity ring buffer of input events for a single action */
+struct FInputActionBuffer
+{
+	/** Max number of events kept per action. Older events are overwritten */
+	static constexpr int32 Capacity = 8;
+
+	/** Event storage */
+	FBufferedInputEvent Events[Capacity];
+
+	/** Index of the next event to write */
+	int32 Head = 0;
+
+	/** Number of valid events */
+	int32 Num = 0;
+
+	/** Input to action latency stats */
+	int32 ConsumedCount = 0;
+	uint64 TotalLatencyFrames = 0;
+	uint64 MaxLatencyFrames = 0;
+	double TotalLatencyMs = 0.0;
+	double MaxLatencyMs = 0.0;
+};
+
+/**
+ *  Buffers timestamped input events per action so characters can act on them
+ *  on the earliest legal frame, e.g. queued combo attacks or jumps pressed just before landing.
+ *  Also measures the latency between an input being received and the action consuming it.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class UInputBufferComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Buffered events for each action */
+	TMap<FName, FInputActionBuffer> ActionBuffers;
+
+public:
+
+	/** Constructor */
+	UInputBufferComponent();
+
+	/**
+	 *  Records an input event for the provided action.
+	 *  Only buffer inputs that can't be acted on right away, so the latency stats only cover deferred inputs.
+	 */
+	void BufferInput(FName Action);
+
+	/** Returns true if there is an unconsumed input for the action no older than MaxAge */
+	bool HasBufferedInput(FName Action, float MaxAge) const;
+
+	/**
+	 *  Consumes the most recent unconsumed input for the action no older than MaxAge.
+	 *  Older inputs for the action are discarded. Returns true if an input was consumed.
+	 */
+	bool ConsumeInput(FName Action, float MaxAge);
+
+	/** Discards all buffered inputs for the action */
+	void ClearInput(FName Action);
+
+	/** Logs the input to action latency stats for all actions */
+	void LogLatencyStats() const;
+
+	/** Resets the latency stats for all actions */
+	void ResetLatencyStats();
+
+protected:
+
+	/** Returns the index of the most recent unconsumed event no older than MaxAge, or INDEX_NONE */
+	int32 FindBufferedInput(const FInputActionBuffer& Buffer, float MaxAge) const;
+};
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MobileControlsLoader.h"
+#include "GameFramework/PlayerController.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/AssetManager.h"
+#include "AssetLoadingSettings.h"
+#include "MyProject.h"
+
+void FMobileControlsLoader::Load(APlayerController* OwningController, const TSoftClassPtr<UUserWidget>& WidgetClass)
+{
+	check(OwningController);
+
+	// is the mobile controls widget class set?
+	if (WidgetClass.IsNull())
+	{
+		UE_LOG(LogMyProject, Error, TEXT("Could not spawn mobile controls widget."));
+		return;
+	}
+
+	LoadStartTime = FPlatformTime::Seconds();
+
+	if (GetDefault<UMyProjectAssetLoadingSettings>()->bAsyncLoadMobileControls)
+	{
+		// load the widget class asynchronously and spawn it when it's ready. The controller owns this loader, so it's safe to capture while the controller is alive
+		LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(WidgetClass.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(OwningController, [this, OwningController, WidgetClass]()
+		{
+			Spawn(OwningController, WidgetClass);
+		}));
+
+	} else {
+
+		// load the widget class now and spawn it right away
+		WidgetClass.LoadSynchronous();
+		Spawn(OwningController, WidgetClass);
+	}
+}
+
+void FMobileControlsLoader::Spawn(APlayerController* OwningController, const TSoftClassPtr<UUserWidget>& WidgetClass)
+{
+	UE_LOG(LogMyProject, Log, TEXT("Loaded mobile controls widget class %s in %.2f ms"), *WidgetClass.ToString(), (FPlatformTime::Seconds() - LoadStartTime) * 1000.0);
+
+	// spawn the mobile controls widget
+	Widget = CreateWidget<UUserWidget>(OwningController, WidgetClass.Get());
+
+	if (Widget)
+	{
+		// add the controls to the player screen
+		Widget->AddToPlayerScreen(0);
+
+	} else {
+
+		UE_LOG(LogMyProject, Error, TEXT("Could not spawn mobile controls widget."));
+
+	}
+
+	// release the load handle, the widget now keeps the class alive
+	LoadHandle.Reset();
+}
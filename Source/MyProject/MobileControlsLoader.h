@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "MobileControlsLoader.generated.h"
+
+class APlayerController;
+class UUserWidget;
+
+/**
+ *  Loads a player controller's soft referenced mobile controls widget class and adds the widget to the player's screen.
+ *  The class is streamed in asynchronously if enabled in the Asset Loading settings, otherwise it's loaded right away.
+ *  Shared by the player controllers of every variant.
+ */
+USTRUCT()
+struct FMobileControlsLoader
+{
+	GENERATED_BODY()
+
+	/** Pointer to the spawned mobile controls widget */
+	UPROPERTY()
+	TObjectPtr<UUserWidget> Widget;
+
+	/** Handle to the in-flight async load of the widget class */
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	/** Platform time when the widget class load was requested, used to report the load time */
+	double LoadStartTime = 0.0;
+
+	/** Loads the widget class and adds the widget to the owning player's screen once it's ready */
+	void Load(APlayerController* OwningController, const TSoftClassPtr<UUserWidget>& WidgetClass);
+
+protected:
+
+	/** Creates the widget once its class has finished loading */
+	void Spawn(APlayerController* OwningController, const TSoftClassPtr<UUserWidget>& WidgetClass);
+};
@@ -15,10 +15,13 @@ public class MyProject : ModuleRules
 			"InputCore",
 			"EnhancedInput",
 			"AIModule",
+			"NavigationSystem",
 			"StateTreeModule",
 			"GameplayStateTreeModule",
 			"UMG",
-			"Slate"
+			"Slate",
+			"DeveloperSettings",
+			"AnimationBudgetAllocator"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
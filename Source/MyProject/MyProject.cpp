@@ -2,7 +2,127 @@
 
 #include "MyProject.h"
 #include "Modules/ModuleManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/World.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, MyProject, "MyProject" );
+DEFINE_LOG_CATEGORY(LogMyProject)
 
-DEFINE_LOG_CATEGORY(LogMyProject)
\ No newline at end of file
+namespace MyProjectStartup
+{
+	/** Recursively logs the /Game package dependency chain of the provided package */
+	static void DumpPackageDependencies(IAssetRegistry& AssetRegistry, FName PackageName, int32 Depth, int32 MaxDepth, TSet<FName>& VisitedPackages, int64& TotalDiskSize)
+	{
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		for (const FName& Dependency : Dependencies)
+		{
+			// engine and script packages are resident anyway, only report content packages
+			FNameBuilder DependencyName(Dependency);
+
+			if (!DependencyName.ToView().StartsWith(TEXT("/Game/")))
+			{
+				continue;
+			}
+
+			// have we already reported this package through another chain?
+			bool bAlreadyVisited = false;
+			VisitedPackages.Add(Dependency, &bAlreadyVisited);
+
+			// get the on-disk size of the package
+			int64 DiskSize = 0;
+
+			if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Dependency))
+			{
+				DiskSize = PackageData->DiskSize;
+			}
+
+			if (!bAlreadyVisited)
+			{
+				TotalDiskSize += FMath::Max<int64>(DiskSize, 0);
+			}
+
+			UE_LOG(LogMyProject, Display, TEXT("%s%s (%.1f KB)%s"), *FString::ChrN(Depth * 2, TEXT(' ')), DependencyName.ToString(), DiskSize / 1024.0, bAlreadyVisited ? TEXT(" [already listed]") : TEXT(""));
+
+			// only expand each package once
+			if (!bAlreadyVisited && Depth < MaxDepth)
+			{
+				DumpPackageDependencies(AssetRegistry, Dependency, Depth + 1, MaxDepth, VisitedPackages, TotalDiskSize);
+			}
+		}
+	}
+
+	/** Logs the package dependency chains that get hard loaded with the current game mode's default pawn */
+	static FAutoConsoleCommandWithWorldAndArgs DumpPawnDependenciesCommand(
+		TEXT("MyProject.DumpPawnDependencies"),
+		TEXT("Logs the hard package dependency chains of the current game mode's default pawn. Optional argument: max depth (default 8)"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr;
+
+			if (!GameMode || !GameMode->DefaultPawnClass)
+			{
+				UE_LOG(LogMyProject, Warning, TEXT("No default pawn class to report dependencies for."));
+				return;
+			}
+
+			const int32 MaxDepth = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8;
+
+			IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+			const FName PawnPackage = GameMode->DefaultPawnClass->GetPackage()->GetFName();
+
+			UE_LOG(LogMyProject, Display, TEXT("Hard dependencies of %s (%s):"), *PawnPackage.ToString(), *GameMode->GetClass()->GetName());
+
+			TSet<FName> VisitedPackages;
+			int64 TotalDiskSize = 0;
+
+			DumpPackageDependencies(AssetRegistry, PawnPackage, 1, MaxDepth, VisitedPackages, TotalDiskSize);
+
+			UE_LOG(LogMyProject, Display, TEXT("%d unique content packages, %.2f MB on disk"), VisitedPackages.Num(), TotalDiskSize / (1024.0 * 1024.0));
+		})
+	);
+}
+
+/**
+ *  Primary game module
+ *  Reports the time between module startup and each map becoming playable.
+ *  Per-package load timings are available through Unreal Insights with -trace=loadtime
+ */
+class FMyProjectModule : public FDefaultGameModuleImpl
+{
+	/** Time at which the module was started */
+	double StartupTime = 0.0;
+
+	/** Handle for the post load map delegate */
+	FDelegateHandle PostLoadMapHandle;
+
+public:
+
+	virtual void StartupModule() override
+	{
+		StartupTime = FPlatformTime::Seconds();
+
+		PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FMyProjectModule::OnPostLoadMap);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	}
+
+private:
+
+	void OnPostLoadMap(UWorld* LoadedWorld)
+	{
+		if (LoadedWorld)
+		{
+			UE_LOG(LogMyProject, Log, TEXT("Map %s loaded %.3fs after module startup"), *LoadedWorld->GetMapName(), FPlatformTime::Seconds() - StartupTime);
+		}
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FMyProjectModule, MyProject, "MyProject" );
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "MyProjectCollisionChannels.h"
+#include "MyProject.h"
+#include "TraceBufferSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+namespace MyProjectCollision
+{
+	/** Sweeps repeatedly with the provided object types and logs the average hit count, cost and hit buffer growths */
+	static void BenchmarkSweep(UWorld* World, const TCHAR* Label, const FCollisionObjectQueryParams& ObjectParams, const FVector& Start, const FVector& End, float Radius, const FCollisionQueryParams& QueryParams, int32 Iterations)
+	{
+		const UTraceBufferSubsystem* TraceBuffers = World->GetSubsystem<UTraceBufferSubsystem>();
+		const uint32 StartGrowths = TraceBuffers ? TraceBuffers->GetNumGrowths() : 0;
+
+		int64 TotalHits = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			// borrow the buffer per sweep, the same way gameplay traces do
+			FScopedHitBuffer OutHits(World);
+			World->SweepMultiByObjectType(*OutHits, Start, End, FQuat::Identity, ObjectParams, FCollisionShape::MakeSphere(Radius), QueryParams);
+
+			TotalHits += OutHits->Num();
+		}
+
+		const double ElapsedUs = (FPlatformTime::Seconds() - StartTime) * 1000000.0;
+		const uint32 Growths = TraceBuffers ? TraceBuffers->GetNumGrowths() - StartGrowths : 0;
+
+		UE_LOG(LogMyProject, Display, TEXT("  %-24s %6.2f hits/sweep  %8.2f us/sweep  %4u buffer growths"), Label, double(TotalHits) / Iterations, ElapsedUs / Iterations, Growths);
+	}
+
+	/** Compares the legacy broad object type sets against the dedicated channel sets around the player */
+	static FAutoConsoleCommandWithWorldAndArgs BenchmarkSweepsCommand(
+		TEXT("MyProject.Collision.BenchmarkSweeps"),
+		TEXT("Compares gameplay sweeps using the legacy Pawn/WorldDynamic object types against the dedicated collision channels, around the first player pawn. Also reports hit buffer growths, which should be zero. Usage: MyProject.Collision.BenchmarkSweeps [Iterations] [Radius]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+			APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+
+			if (!Pawn)
+			{
+				UE_LOG(LogMyProject, Warning, TEXT("BenchmarkSweeps requires a player pawn."));
+				return;
+			}
+
+			const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+			const float Radius = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.0f) : 200.0f;
+
+			const FVector Start = Pawn->GetActorLocation();
+			const FVector End = Start + Pawn->GetActorForwardVector() * 150.0f;
+
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(BenchmarkSweeps), false, Pawn);
+
+			UE_LOG(LogMyProject, Display, TEXT("Sweep benchmark: %d iterations, %.0f cm radius"), Iterations, Radius);
+
+			BenchmarkSweep(World, TEXT("Attack (legacy)"), FCollisionObjectQueryParams(ECC_TO_BITFIELD(ECC_Pawn) | ECC_TO_BITFIELD(ECC_WorldDynamic)), Start, End, Radius, QueryParams, Iterations);
+			BenchmarkSweep(World, TEXT("Attack (channels)"), PlayerAttackObjects(), Start, End, Radius, QueryParams, Iterations);
+			BenchmarkSweep(World, TEXT("Danger (legacy)"), FCollisionObjectQueryParams(ECC_TO_BITFIELD(ECC_Pawn)), Start, End, Radius, QueryParams, Iterations);
+			BenchmarkSweep(World, TEXT("Danger (channels)"), IncomingAttackObjects(), Start, End, Radius, QueryParams, Iterations);
+			BenchmarkSweep(World, TEXT("Interaction (legacy)"), FCollisionObjectQueryParams(ECC_TO_BITFIELD(ECC_Pawn) | ECC_TO_BITFIELD(ECC_WorldDynamic)), Start, End, Radius, QueryParams, Iterations);
+			BenchmarkSweep(World, TEXT("Interaction (channels)"), InteractionObjects(), Start, End, Radius, QueryParams, Iterations);
+		}));
+}
@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+#include "CollisionQueryParams.h"
+
+/**
+ *  Project specific collision channels. These must match the channel setup in DefaultEngine.ini
+ */
+
+/** Object channel for AI combat enemies, so enemy attack sweeps for pawns never return other enemies */
+#define ECC_CombatEnemy ECC_GameTraceChannel1
+
+/** Object channel for damageable props and targets, such as breakable boxes and training dummies */
+#define ECC_Hurtbox ECC_GameTraceChannel2
+
+/** Object channel for query only volumes found by interaction sweeps */
+#define ECC_Interactable ECC_GameTraceChannel3
+
+/** Object channel for one way platforms that characters can drop through */
+#define ECC_SoftPlatform ECC_GameTraceChannel4
+
+/** Object channel for launch surfaces. Ignored by default, so only characters that can be launched stand on them */
+#define ECC_LaunchSurface ECC_GameTraceChannel5
+
+/**
+ *  Object type sets for the project's gameplay queries.
+ *  Each set only includes the object channels the query can act on, to keep broadphase candidates low.
+ */
+namespace MyProjectCollision
+{
+	/** Objects hit by player melee attacks: enemies and damageable props */
+	inline FCollisionObjectQueryParams PlayerAttackObjects()
+	{
+		return FCollisionObjectQueryParams(ECC_TO_BITFIELD(ECC_CombatEnemy) | ECC_TO_BITFIELD(ECC_Hurtbox));
+	}
+
+	/** Objects warned about incoming player attacks: enemies only */
+	inline FCollisionObjectQueryParams IncomingAttackObjects()
+	{
+		return FCollisionObjectQueryParams(ECC_TO_BITFIELD(ECC_CombatEnemy));
+	}
+
+	/** Objects hit by enemy melee attacks: player pawns only */
+	inline FCollisionObjectQueryParams EnemyAttackObjects()
+	{
+		return FCollisionObjectQueryParams(ECC_TO_BITFIELD(ECC_Pawn));
+	}
+
+	/** Objects found by interaction sweeps: NPC pawns and interaction volumes */
+	inline FCollisionObjectQueryParams InteractionObjects()
+	{
+		return FCollisionObjectQueryParams(ECC_TO_BITFIELD(ECC_Pawn) | ECC_TO_BITFIELD(ECC_Interactable));
+	}
+}
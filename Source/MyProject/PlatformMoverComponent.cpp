@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "PlatformMoverComponent.h"
+#include "PlatformMoverSubsystem.h"
+#include "Components/SplineComponent.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Algo/BinarySearch.h"
+
+UPlatformMoverComponent::UPlatformMoverComponent()
+{
+	// movers are advanced in a batch by the subsystem
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UPlatformMoverComponent::Play()
+{
+	if (!HasPath() || IsMoving())
+	{
+		return;
+	}
+
+	// head towards the opposite end
+	Direction = PathAlpha >= 1.0f ? -1.0f : 1.0f;
+
+	if (UPlatformMoverSubsystem* Movers = GetWorld()->GetSubsystem<UPlatformMoverSubsystem>())
+	{
+		Movers->AddActiveMover(this);
+	}
+}
+
+void UPlatformMoverComponent::Stop()
+{
+	if (UPlatformMoverSubsystem* Movers = GetWorld()->GetSubsystem<UPlatformMoverSubsystem>())
+	{
+		Movers->RemoveActiveMover(this);
+	}
+}
+
+bool UPlatformMoverComponent::Advance(float DeltaTime)
+{
+	USceneComponent* Root = GetOwner()->GetRootComponent();
+
+	if (!Root)
+	{
+		return false;
+	}
+
+	PathAlpha += Direction * DeltaTime / Duration;
+
+	bool bKeepMoving = true;
+
+	// have we reached either end?
+	if (PathAlpha >= 1.0f || PathAlpha <= 0.0f)
+	{
+		PathAlpha = FMath::Clamp(PathAlpha, 0.0f, 1.0f);
+
+		if (bLoop)
+		{
+			Direction = -Direction;
+
+		} else {
+
+			bKeepMoving = false;
+		}
+	}
+
+	// move the platform. Based characters follow it during their own movement update
+	const float EasedAlpha = FMath::InterpEaseInOut(0.0f, 1.0f, PathAlpha, EaseExponent);
+
+	Root->SetWorldLocation(GetLocationAtDistance(EasedAlpha * PathDistances.Last()));
+
+	return bKeepMoving;
+}
+
+void UPlatformMoverComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BuildPath();
+
+	if (bAutoStart)
+	{
+		Play();
+	}
+}
+
+void UPlatformMoverComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Stop();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UPlatformMoverComponent::BuildPath()
+{
+	StartTransform = GetOwner()->GetActorTransform();
+
+	WorldPath.Reset();
+
+	// bake the spline into points so it doesn't move along with the platform it's attached to
+	USplineComponent* Spline = bUseSpline ? GetOwner()->FindComponentByClass<USplineComponent>() : nullptr;
+
+	if (Spline)
+	{
+		const float SplineLength = Spline->GetSplineLength();
+		const int32 NumSamples = FMath::Max(1, FMath::CeilToInt(SplineLength / SplineSampleDistance));
+
+		for (int32 i = 0; i <= NumSamples; ++i)
+		{
+			WorldPath.Add(Spline->GetLocationAtDistanceAlongSpline(SplineLength * i / NumSamples, ESplineCoordinateSpace::World));
+		}
+
+	} else {
+
+		WorldPath.Add(StartTransform.GetLocation());
+
+		for (const FVector& Point : PathPoints)
+		{
+			WorldPath.Add(StartTransform.TransformPosition(Point));
+		}
+	}
+
+	// accumulate the distance along the path for each point
+	PathDistances.SetNumUninitialized(WorldPath.Num());
+	PathDistances[0] = 0.0f;
+
+	for (int32 i = 1; i < WorldPath.Num(); ++i)
+	{
+		PathDistances[i] = PathDistances[i - 1] + FVector::Dist(WorldPath[i - 1], WorldPath[i]);
+	}
+
+	PathAlpha = 0.0f;
+	Direction = 1.0f;
+}
+
+FVector UPlatformMoverComponent::GetLocationAtDistance(float Distance) const
+{
+	// find the segment containing the distance
+	const int32 Segment = FMath::Clamp(Algo::UpperBound(PathDistances, Distance) - 1, 0, PathDistances.Num() - 2);
+
+	const float SegmentLength = PathDistances[Segment + 1] - PathDistances[Segment];
+	const float SegmentAlpha = SegmentLength > UE_KINDA_SMALL_NUMBER ? (Distance - PathDistances[Segment]) / SegmentLength : 0.0f;
+
+	return FMath::Lerp(WorldPath[Segment], WorldPath[Segment + 1], FMath::Clamp(SegmentAlpha, 0.0f, 1.0f));
+}
@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "PlatformMoverComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPlatformMoveFinished);
+
+/**
+ *  Natively moves its owner's root component along a keyed or spline path.
+ *  Movers don't tick on their own. While moving, they're advanced in a single batched update
+ *  by the platform mover subsystem, which runs before character movement so based characters
+ *  always follow the platform's position for the current frame.
+ *  The owner's root component must be movable.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class UPlatformMoverComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Path points, relative to the owner's transform on BeginPlay. The path starts at the owner's location */
+	UPROPERTY(EditAnywhere, Category="Path", meta = (MakeEditWidget))
+	TArray<FVector> PathPoints;
+
+	/** If true, the path is baked from the first spline component on the owner instead of the path points */
+	UPROPERTY(EditAnywhere, Category="Path")
+	bool bUseSpline = false;
+
+	/** Distance between points baked from the spline */
+	UPROPERTY(EditAnywhere, Category="Path", meta = (ClampMin = 1, ClampMax = 1000, Units = "cm", EditCondition = "bUseSpline"))
+	float SplineSampleDistance = 50.0f;
+
+	/** Time to travel the whole path */
+	UPROPERTY(EditAnywhere, Category="Movement", meta = (ClampMin = 0.01, ClampMax = 60, Units = "s"))
+	float Duration = 5.0f;
+
+	/** Ease in and out exponent. 1 moves at a constant speed */
+	UPROPERTY(EditAnywhere, Category="Movement", meta = (ClampMin = 1, ClampMax = 10))
+	float EaseExponent = 2.0f;
+
+	/** If true, the platform keeps moving back and forth along the path until stopped */
+	UPROPERTY(EditAnywhere, Category="Movement")
+	bool bLoop = false;
+
+	/** If true, the platform starts moving on BeginPlay */
+	UPROPERTY(EditAnywhere, Category="Movement")
+	bool bAutoStart = false;
+
+	/** Called when the platform reaches either end of the path, unless looping */
+	UPROPERTY(BlueprintAssignable, Category="Movement")
+	FOnPlatformMoveFinished OnMoveFinished;
+
+protected:
+
+	/** Owner transform on BeginPlay. Path points are relative to this */
+	FTransform StartTransform;
+
+	/** Path in world space, starting at the owner's location or the spline start */
+	TArray<FVector> WorldPath;
+
+	/** Distance along the path at each world path point */
+	TArray<float> PathDistances;
+
+	/** Current position along the path, from 0 at the start to 1 at the end */
+	float PathAlpha = 0.0f;
+
+	/** Current direction of travel. 1 moves towards the end of the path */
+	float Direction = 1.0f;
+
+	/** Index in the subsystem's active mover list, or INDEX_NONE if we're not moving */
+	int32 ActiveIndex = INDEX_NONE;
+
+	friend class UPlatformMoverSubsystem;
+
+public:
+
+	/** Constructor */
+	UPlatformMoverComponent();
+
+	/** Starts moving towards the end of the path opposite to the last one we moved to */
+	UFUNCTION(BlueprintCallable, Category="Movement")
+	void Play();
+
+	/** Stops the platform at its current position */
+	UFUNCTION(BlueprintCallable, Category="Movement")
+	void Stop();
+
+	/** Returns true if the platform is currently moving */
+	UFUNCTION(BlueprintPure, Category="Movement")
+	bool IsMoving() const { return ActiveIndex != INDEX_NONE; }
+
+	/** Returns true if there's a path to move along */
+	bool HasPath() const { return WorldPath.Num() > 1; }
+
+	/** Advances the platform along the path. Called by the subsystem. Returns false once the platform has stopped */
+	bool Advance(float DeltaTime);
+
+protected:
+
+	/** Builds the path and starts moving if needed */
+	virtual void BeginPlay() override;
+
+	/** Unregisters from the subsystem */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Builds the world space path from the path points or spline */
+	void BuildPath();
+
+	/** Returns the world location at the given distance along the path */
+	FVector GetLocationAtDistance(float Distance) const;
+};
@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "PlatformMoverSubsystem.h"
+#include "PlatformMoverComponent.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+DECLARE_STATS_GROUP(TEXT("PlatformMovers"), STATGROUP_PlatformMovers, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Platform Mover Batch"), STAT_PlatformMoverBatch, STATGROUP_PlatformMovers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Moving Platforms"), STAT_PlatformMoversActive, STATGROUP_PlatformMovers);
+
+void FPlatformMoverTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->UpdateMovers(DeltaTime);
+	}
+}
+
+FString FPlatformMoverTickFunction::DiagnosticMessage()
+{
+	return TEXT("FPlatformMoverTickFunction");
+}
+
+void UPlatformMoverSubsystem::AddActiveMover(UPlatformMoverComponent* Mover)
+{
+	if (!Mover || Mover->ActiveIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Mover->ActiveIndex = ActiveMovers.Add(Mover);
+}
+
+void UPlatformMoverSubsystem::RemoveActiveMover(UPlatformMoverComponent* Mover)
+{
+	if (!Mover || !ActiveMovers.IsValidIndex(Mover->ActiveIndex) || ActiveMovers[Mover->ActiveIndex] != Mover)
+	{
+		return;
+	}
+
+	// swap the last mover into the freed slot
+	const int32 Index = Mover->ActiveIndex;
+
+	ActiveMovers.RemoveAtSwap(Index, EAllowShrinking::No);
+
+	if (ActiveMovers.IsValidIndex(Index))
+	{
+		ActiveMovers[Index]->ActiveIndex = Index;
+	}
+
+	Mover->ActiveIndex = INDEX_NONE;
+}
+
+void UPlatformMoverSubsystem::AddMovementPrerequisite(FTickFunction& TickFunction)
+{
+	TickFunction.AddPrerequisite(this, BatchTick);
+}
+
+void UPlatformMoverSubsystem::UpdateMovers(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PlatformMoverBatch);
+	INC_DWORD_STAT_BY(STAT_PlatformMoversActive, ActiveMovers.Num());
+
+	// movers that reached the end of their path this frame
+	TArray<UPlatformMoverComponent*, TInlineAllocator<16>> FinishedMovers;
+
+	for (int32 i = ActiveMovers.Num() - 1; i >= 0; --i)
+	{
+		UPlatformMoverComponent* Mover = ActiveMovers[i];
+
+		if (!IsValid(Mover))
+		{
+			ActiveMovers.RemoveAtSwap(i, EAllowShrinking::No);
+
+			if (ActiveMovers.IsValidIndex(i))
+			{
+				ActiveMovers[i]->ActiveIndex = i;
+			}
+
+			continue;
+		}
+
+		if (!Mover->Advance(DeltaTime))
+		{
+			RemoveActiveMover(Mover);
+			FinishedMovers.Add(Mover);
+		}
+	}
+
+	// notify once the active list is stable, so handlers can restart movers
+	for (UPlatformMoverComponent* Mover : FinishedMovers)
+	{
+		Mover->OnMoveFinished.Broadcast();
+	}
+}
+
+void UPlatformMoverSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// run the batch first in the pre-physics group, ahead of character movement
+	BatchTick.Target = this;
+	BatchTick.TickGroup = TG_PrePhysics;
+	BatchTick.bHighPriority = true;
+	BatchTick.bCanEverTick = true;
+	BatchTick.bStartWithTickEnabled = true;
+	BatchTick.bTickEvenWhenPaused = false;
+
+	BatchTick.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UPlatformMoverSubsystem::Deinitialize()
+{
+	if (BatchTick.IsTickFunctionRegistered())
+	{
+		BatchTick.UnRegisterTickFunction();
+	}
+
+	BatchTick.Target = nullptr;
+
+	for (UPlatformMoverComponent* Mover : ActiveMovers)
+	{
+		if (Mover)
+		{
+			Mover->ActiveIndex = INDEX_NONE;
+		}
+	}
+
+	ActiveMovers.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UPlatformMoverSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "PlatformMoverSubsystem.generated.h"
+
+class UPlatformMoverSubsystem;
+class UPlatformMoverComponent;
+
+/** Tick function that advances all moving platforms in a single batch */
+struct FPlatformMoverTickFunction : public FTickFunction
+{
+	/** Subsystem to update */
+	UPlatformMoverSubsystem* Target = nullptr;
+
+	/** Advances the platforms */
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	/** Name for tick diagnostics */
+	virtual FString DiagnosticMessage() override;
+};
+
+/**
+ *  Advances all moving platform movers in a single batched update.
+ *  Only movers that are currently moving are updated. The batch runs early in the pre-physics tick group,
+ *  and movement components can add it as a tick prerequisite so based characters always move after their platform.
+ *  Use "stat PlatformMovers" to see the batch cost and the number of moving platforms.
+ */
+UCLASS()
+class UPlatformMoverSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Batched tick function */
+	FPlatformMoverTickFunction BatchTick;
+
+	/** Movers currently moving */
+	UPROPERTY()
+	TArray<TObjectPtr<UPlatformMoverComponent>> ActiveMovers;
+
+public:
+
+	/** Starts updating the mover */
+	void AddActiveMover(UPlatformMoverComponent* Mover);
+
+	/** Stops updating the mover */
+	void RemoveActiveMover(UPlatformMoverComponent* Mover);
+
+	/** Makes the tick function run after the platform batch update. Used by movement components that can stand on platforms */
+	void AddMovementPrerequisite(FTickFunction& TickFunction);
+
+	/** Advances all active movers */
+	void UpdateMovers(float DeltaTime);
+
+	/** Registers the batched tick function */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+protected:
+
+	/** Only create for game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
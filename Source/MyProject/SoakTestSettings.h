@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "SoakTestSettings.generated.h"
+
+/**
+ *  Project settings for the soak test monitor.
+ *  Controls the maps cycled during a soak run, the scripted bot behavior,
+ *  and how much resource growth is allowed before the run fails.
+ */
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Soak Test"))
+class UMyProjectSoakTestSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Maps to cycle through during the soak run */
+	UPROPERTY(Config, EditAnywhere, Category="Run")
+	TArray<TSoftObjectPtr<UWorld>> Maps;
+
+	/** Time to stay on each map before traveling to the next one */
+	UPROPERTY(Config, EditAnywhere, Category="Run", meta = (ClampMin = 1, ClampMax = 240, Units = "min"))
+	float MinutesPerMap = 20.0f;
+
+	/** Length of the run, unless overridden with -SoakHours= */
+	UPROPERTY(Config, EditAnywhere, Category="Run", meta = (ClampMin = 0.1, ClampMax = 72, Units = "h"))
+	float DefaultDurationHours = 4.0f;
+
+	/** Time between the bot's changes of movement direction */
+	UPROPERTY(Config, EditAnywhere, Category="Bots", meta = (ClampMin = 0.1, ClampMax = 60, Units = "s"))
+	float BotDirectionInterval = 2.0f;
+
+	/** Time between forced deaths of the player pawn, to exercise respawning. 0 disables */
+	UPROPERTY(Config, EditAnywhere, Category="Bots", meta = (ClampMin = 0, ClampMax = 600, Units = "s"))
+	float BotKillInterval = 45.0f;
+
+	/** Extra time allowed past the kill interval for a death to happen before the run fails. Covers map travel and respawn delays */
+	UPROPERTY(Config, EditAnywhere, Category="Bots", meta = (ClampMin = 0, ClampMax = 600, Units = "s"))
+	float BotDeathGracePeriod = 30.0f;
+
+	/** Time between resource samples. A full garbage collection runs before each sample */
+	UPROPERTY(Config, EditAnywhere, Category="Sampling", meta = (ClampMin = 1, ClampMax = 600, Units = "s"))
+	float SampleInterval = 60.0f;
+
+	/** Samples to skip before checking for growth, so caches and pools can warm up */
+	UPROPERTY(Config, EditAnywhere, Category="Sampling", meta = (ClampMin = 0, ClampMax = 100))
+	int32 WarmupSamples = 5;
+
+	/** Number of recent samples used to measure growth. Should span several map cycles */
+	UPROPERTY(Config, EditAnywhere, Category="Sampling", meta = (ClampMin = 3, ClampMax = 1000))
+	int32 GrowthWindowSamples = 60;
+
+	/** Max allowed growth of the UObject count, in objects per hour */
+	UPROPERTY(Config, EditAnywhere, Category="Limits", meta = (ClampMin = 0))
+	float MaxObjectGrowthPerHour = 2000.0f;
+
+	/** Max allowed growth of resident memory, in MB per hour */
+	UPROPERTY(Config, EditAnywhere, Category="Limits", meta = (ClampMin = 0))
+	float MaxMemoryGrowthPerHour = 64.0f;
+
+	/** Max allowed growth of dynamic delegate bindings on actor lifetime events, in bindings per hour */
+	UPROPERTY(Config, EditAnywhere, Category="Limits", meta = (ClampMin = 0))
+	float MaxDelegateGrowthPerHour = 200.0f;
+
+	/** Max allowed growth of the average garbage collection time, in ms per hour */
+	UPROPERTY(Config, EditAnywhere, Category="Limits", meta = (ClampMin = 0))
+	float MaxGCTimeGrowthPerHour = 5.0f;
+};
@@ -0,0 +1,306 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SoakTestSubsystem.h"
+#include "SoakTestSettings.h"
+#include "MyProject.h"
+#include "EngineUtils.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+
+bool USoakTestSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("SoakTest"));
+}
+
+void USoakTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UMyProjectSoakTestSettings* Settings = GetDefault<UMyProjectSoakTestSettings>();
+
+	float DurationHours = Settings->DefaultDurationHours;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakHours="), DurationHours);
+
+	StartTime = FPlatformTime::Seconds();
+	EndTime = StartTime + DurationHours * 3600.0;
+
+	NextSampleTime = StartTime + Settings->SampleInterval;
+	NextMapTime = StartTime + Settings->MinutesPerMap * 60.0;
+	NextBotKillTime = StartTime + Settings->BotKillInterval;
+	LastBotDeathTime = StartTime;
+
+	// time every garbage collection, including the ones we force before sampling
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &USoakTestSubsystem::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &USoakTestSubsystem::OnPostGarbageCollect);
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &USoakTestSubsystem::Tick));
+
+	UE_LOG(LogMyProject, Display, TEXT("Soak test started: %.1f hours, %d maps"), DurationHours, Settings->Maps.Num());
+}
+
+void USoakTestSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	Super::Deinitialize();
+}
+
+bool USoakTestSubsystem::Tick(float DeltaTime)
+{
+	if (bFinished)
+	{
+		return false;
+	}
+
+	const UMyProjectSoakTestSettings* Settings = GetDefault<UMyProjectSoakTestSettings>();
+	const double Now = FPlatformTime::Seconds();
+
+	UWorld* World = GetGameInstance()->GetWorld();
+
+	// wait for map travel to finish
+	if (!World || !World->HasBegunPlay())
+	{
+		return true;
+	}
+
+	UpdateBot(World, Now);
+
+	// deaths must keep happening, or respawning is broken and the run isn't exercising it
+	if (Settings->BotKillInterval > 0.0f && Now - LastBotDeathTime > Settings->BotKillInterval + Settings->BotDeathGracePeriod)
+	{
+		UE_LOG(LogMyProject, Error, TEXT("Soak test: the player pawn hasn't died in %.0f seconds"), Now - LastBotDeathTime);
+
+		Finish(false);
+		return false;
+	}
+
+	if (Now >= NextSampleTime)
+	{
+		NextSampleTime = Now + Settings->SampleInterval;
+		TakeSample(World, Now);
+
+		if (!CheckGrowth())
+		{
+			Finish(false);
+			return false;
+		}
+	}
+
+	if (Now >= EndTime)
+	{
+		Finish(true);
+		return false;
+	}
+
+	// travel to the next map
+	if (Now >= NextMapTime && Settings->Maps.Num() > 0)
+	{
+		NextMapTime = Now + Settings->MinutesPerMap * 60.0;
+
+		const TSoftObjectPtr<UWorld>& Map = Settings->Maps[NextMapIndex];
+		NextMapIndex = (NextMapIndex + 1) % Settings->Maps.Num();
+
+		UE_LOG(LogMyProject, Display, TEXT("Soak test traveling to %s"), *Map.ToString());
+
+		UGameplayStatics::OpenLevelBySoftObjectPtr(World, Map);
+	}
+
+	return true;
+}
+
+void USoakTestSubsystem::UpdateBot(UWorld* World, double Now)
+{
+	const UMyProjectSoakTestSettings* Settings = GetDefault<UMyProjectSoakTestSettings>();
+
+	APlayerController* PC = GetGameInstance()->GetFirstLocalPlayerController(World);
+	APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+
+	if (!Pawn)
+	{
+		return;
+	}
+
+	// pick a new direction and jump every now and then
+	if (Now >= NextBotDirectionTime)
+	{
+		NextBotDirectionTime = Now + Settings->BotDirectionInterval;
+
+		const float Angle = FMath::FRandRange(0.0f, 2.0f * UE_PI);
+		BotDirection = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
+
+		if (ACharacter* Character = Cast<ACharacter>(Pawn))
+		{
+			Character->Jump();
+		}
+	}
+
+	Pawn->AddMovementInput(BotDirection);
+
+	// kill the pawn to exercise death and respawning
+	if (Settings->BotKillInterval > 0.0f && Now >= NextBotKillTime)
+	{
+		NextBotKillTime = Now + Settings->BotKillInterval;
+
+		// falling out of the world is handled by every pawn, unlike damage
+		const FVector KillLocation = Pawn->GetActorLocation();
+
+		Pawn->FellOutOfWorld(*GetDefault<UDamageType>());
+
+		// the pawn either gets destroyed and respawned, or reset in place
+		if (!IsValid(Pawn) || Pawn->IsActorBeingDestroyed() || PC->GetPawn() != Pawn || !Pawn->GetActorLocation().Equals(KillLocation))
+		{
+			LastBotDeathTime = Now;
+
+		} else {
+
+			UE_LOG(LogMyProject, Warning, TEXT("Soak test: %s survived falling out of the world"), *Pawn->GetName());
+		}
+	}
+}
+
+void USoakTestSubsystem::TakeSample(UWorld* World, double Now)
+{
+	// collect garbage first so only reachable objects are counted
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	FSoakSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.Time = Now - StartTime;
+	Sample.NumObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Sample.ResidentMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+	Sample.DelegateBindings = CountDelegateBindings(World);
+	Sample.GCMs = NumGCs > 0 ? GCTimeMs / NumGCs : 0.0;
+
+	GCTimeMs = 0.0;
+	NumGCs = 0;
+
+	UE_LOG(LogMyProject, Display, TEXT("Soak sample %d: %.0f objects, %.1f MB resident, %.0f delegate bindings, %.2f ms GC"), Samples.Num(), Sample.NumObjects, Sample.ResidentMB, Sample.DelegateBindings, Sample.GCMs);
+}
+
+bool USoakTestSubsystem::CheckGrowth() const
+{
+	const UMyProjectSoakTestSettings* Settings = GetDefault<UMyProjectSoakTestSettings>();
+
+	const int32 WindowSize = Settings->GrowthWindowSamples;
+
+	// wait until there's a full window of samples past the warmup
+	if (Samples.Num() - Settings->WarmupSamples < WindowSize)
+	{
+		return true;
+	}
+
+	const TConstArrayView<FSoakSample> Window = MakeArrayView(Samples).Right(WindowSize);
+
+	// least squares slope of the metric over the window, per hour
+	auto GetGrowthPerHour = [&Window](double FSoakSample::* Metric)
+	{
+		double MeanTime = 0.0;
+		double MeanValue = 0.0;
+
+		for (const FSoakSample& Sample : Window)
+		{
+			MeanTime += Sample.Time;
+			MeanValue += Sample.*Metric;
+		}
+
+		MeanTime /= Window.Num();
+		MeanValue /= Window.Num();
+
+		double Covariance = 0.0;
+		double Variance = 0.0;
+
+		for (const FSoakSample& Sample : Window)
+		{
+			Covariance += (Sample.Time - MeanTime) * (Sample.*Metric - MeanValue);
+			Variance += FMath::Square(Sample.Time - MeanTime);
+		}
+
+		return Variance > 0.0 ? Covariance / Variance * 3600.0 : 0.0;
+	};
+
+	bool bPassed = true;
+
+	auto CheckMetric = [&bPassed, &GetGrowthPerHour](const TCHAR* Name, double FSoakSample::* Metric, float MaxGrowthPerHour)
+	{
+		const double Growth = GetGrowthPerHour(Metric);
+
+		if (Growth > MaxGrowthPerHour)
+		{
+			UE_LOG(LogMyProject, Error, TEXT("Soak test: %s grew by %.2f per hour, over the limit of %.2f"), Name, Growth, MaxGrowthPerHour);
+			bPassed = false;
+		}
+	};
+
+	CheckMetric(TEXT("UObject count"), &FSoakSample::NumObjects, Settings->MaxObjectGrowthPerHour);
+	CheckMetric(TEXT("Resident memory (MB)"), &FSoakSample::ResidentMB, Settings->MaxMemoryGrowthPerHour);
+	CheckMetric(TEXT("Delegate bindings"), &FSoakSample::DelegateBindings, Settings->MaxDelegateGrowthPerHour);
+	CheckMetric(TEXT("GC time (ms)"), &FSoakSample::GCMs, Settings->MaxGCTimeGrowthPerHour);
+
+	return bPassed;
+}
+
+int32 USoakTestSubsystem::CountDelegateBindings(UWorld* World)
+{
+	int32 NumBindings = 0;
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		NumBindings += It->OnDestroyed.GetAllObjects().Num();
+		NumBindings += It->OnEndPlay.GetAllObjects().Num();
+	}
+
+	return NumBindings;
+}
+
+void USoakTestSubsystem::Finish(bool bPassed)
+{
+	bFinished = true;
+
+	// write the samples
+	FString Csv = TEXT("Time,Objects,ResidentMB,DelegateBindings,GCMs\n");
+
+	for (const FSoakSample& Sample : Samples)
+	{
+		Csv += FString::Printf(TEXT("%.1f,%.0f,%.2f,%.0f,%.3f\n"), Sample.Time, Sample.NumObjects, Sample.ResidentMB, Sample.DelegateBindings, Sample.GCMs);
+	}
+
+	const FString Filename = FPaths::Combine(FPaths::ProfilingDir(), TEXT("SoakTest.csv"));
+	FFileHelper::SaveStringToFile(Csv, *Filename);
+
+	if (bPassed)
+	{
+		UE_LOG(LogMyProject, Display, TEXT("Soak test passed after %d samples. Wrote %s"), Samples.Num(), *Filename);
+
+	} else {
+
+		UE_LOG(LogMyProject, Error, TEXT("Soak test failed after %d samples. Wrote %s"), Samples.Num(), *Filename);
+	}
+
+	FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+}
+
+void USoakTestSubsystem::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void USoakTestSubsystem::OnPostGarbageCollect()
+{
+	GCTimeMs += (FPlatformTime::Seconds() - GCStartTime) * 1000.0;
+	++NumGCs;
+}
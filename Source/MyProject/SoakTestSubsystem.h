@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "SoakTestSubsystem.generated.h"
+
+/**
+ *  Runs an unattended soak test when the game is launched with -SoakTest, for example headless with -nullrhi.
+ *  Cycles through the configured maps while a scripted bot drives the player pawn and periodically kills it.
+ *  The run fails if the pawn stops dying, since that means respawning is no longer being exercised.
+ *  Samples UObject counts, resident memory, actor lifetime delegate bindings and garbage collection time,
+ *  and fails the run with exit code 1 if any of them keeps growing faster than its configured limit.
+ *  Samples are written to Saved/Profiling/SoakTest.csv when the run ends.
+ *  The run length can be overridden with -SoakHours=.
+ */
+UCLASS()
+class USoakTestSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+	/** A single resource sample */
+	struct FSoakSample
+	{
+		/** Seconds since the run started */
+		double Time = 0.0;
+
+		/** Live UObjects after a full garbage collection */
+		double NumObjects = 0.0;
+
+		/** Resident memory */
+		double ResidentMB = 0.0;
+
+		/** Dynamic delegate bindings on actor lifetime events */
+		double DelegateBindings = 0.0;
+
+		/** Average garbage collection time since the last sample */
+		double GCMs = 0.0;
+	};
+
+	/** Samples taken so far */
+	TArray<FSoakSample> Samples;
+
+	/** Core ticker handle. The core ticker keeps running across map travel */
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Garbage collection delegate handles */
+	FDelegateHandle PreGCHandle;
+	FDelegateHandle PostGCHandle;
+
+	/** Platform time the run started and will end */
+	double StartTime = 0.0;
+	double EndTime = 0.0;
+
+	/** Platform time of the next sample, map travel, bot direction change and bot kill */
+	double NextSampleTime = 0.0;
+	double NextMapTime = 0.0;
+	double NextBotDirectionTime = 0.0;
+	double NextBotKillTime = 0.0;
+
+	/** Platform time the player pawn last died */
+	double LastBotDeathTime = 0.0;
+
+	/** Index of the next map to travel to */
+	int32 NextMapIndex = 0;
+
+	/** Direction the bot is moving in */
+	FVector BotDirection = FVector::ForwardVector;
+
+	/** Start time of the garbage collection in progress */
+	double GCStartTime = 0.0;
+
+	/** Garbage collection time and count since the last sample */
+	double GCTimeMs = 0.0;
+	int32 NumGCs = 0;
+
+	/** Set once the run has finished */
+	bool bFinished = false;
+
+public:
+
+	/** Only created for soak runs */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** Starts the run */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+protected:
+
+	/** Drives the run */
+	bool Tick(float DeltaTime);
+
+	/** Moves the player pawn around and periodically kills it */
+	void UpdateBot(UWorld* World, double Now);
+
+	/** Collects garbage and records a resource sample */
+	void TakeSample(UWorld* World, double Now);
+
+	/** Returns false and logs an error if any metric grew faster than allowed over the recent samples */
+	bool CheckGrowth() const;
+
+	/** Counts dynamic delegate bindings on the lifetime events of all actors in the world */
+	static int32 CountDelegateBindings(UWorld* World);
+
+	/** Writes the samples, logs the result and exits */
+	void Finish(bool bPassed);
+
+	/** Garbage collection timing */
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+};
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "TraceBufferSubsystem.h"
+#include "Engine/World.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("TraceBuffers"), STATGROUP_TraceBuffers, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Buffer Growths"), STAT_TraceBufferGrowths, STATGROUP_TraceBuffers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Hit Buffers"), STAT_TraceBufferPooled, STATGROUP_TraceBuffers);
+
+TArray<FHitResult>& UTraceBufferSubsystem::AcquireHitBuffer()
+{
+	// nested deeper than the pool, so add another buffer
+	if (NumHitBuffersInUse >= HitBuffers.Num())
+	{
+		AddHitBuffer();
+
+		++NumGrowths;
+		INC_DWORD_STAT(STAT_TraceBufferGrowths);
+	}
+
+	TArray<FHitResult>& Buffer = HitBuffers[NumHitBuffersInUse++];
+	Buffer.Reset();
+
+	return Buffer;
+}
+
+void UTraceBufferSubsystem::ReleaseHitBuffer(TArray<FHitResult>& Buffer, int32 AcquiredCapacity)
+{
+	check(NumHitBuffersInUse > 0 && &HitBuffers[NumHitBuffersInUse - 1] == &Buffer);
+
+	--NumHitBuffersInUse;
+
+	// the trace returned more hits than the buffer could hold
+	if (Buffer.Max() > AcquiredCapacity)
+	{
+		++NumGrowths;
+		INC_DWORD_STAT(STAT_TraceBufferGrowths);
+	}
+
+	// drop the hits now so we don't keep references to their components and actors around
+	Buffer.Reset();
+}
+
+void UTraceBufferSubsystem::AddHitBuffer()
+{
+	TArray<FHitResult>* Buffer = new TArray<FHitResult>();
+	Buffer->Reserve(InitialHitCapacity);
+
+	HitBuffers.Add(Buffer);
+
+	SET_DWORD_STAT(STAT_TraceBufferPooled, HitBuffers.Num());
+}
+
+void UTraceBufferSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (int32 i = 0; i < InitialNumHitBuffers; ++i)
+	{
+		AddHitBuffer();
+	}
+}
+
+void UTraceBufferSubsystem::Deinitialize()
+{
+	HitBuffers.Empty();
+	NumHitBuffersInUse = 0;
+
+	Super::Deinitialize();
+}
+
+bool UTraceBufferSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FScopedHitBuffer::FScopedHitBuffer(const UWorld* World)
+{
+	Pool = World ? World->GetSubsystem<UTraceBufferSubsystem>() : nullptr;
+
+	if (Pool)
+	{
+		Buffer = &Pool->AcquireHitBuffer();
+		AcquiredCapacity = Buffer->Max();
+
+	} else {
+
+		Buffer = &LocalBuffer;
+	}
+}
+
+FScopedHitBuffer::~FScopedHitBuffer()
+{
+	if (Pool)
+	{
+		Pool->ReleaseHitBuffer(*Buffer, AcquiredCapacity);
+	}
+}
@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/HitResult.h"
+#include "TraceBufferSubsystem.generated.h"
+
+/**
+ *  Per-world pool of hit result buffers for gameplay multi traces.
+ *  Buffers keep their capacity between traces, so once warmed up, traces don't allocate.
+ *  Buffers are handed out in LIFO order through FScopedHitBuffer, so nested traces are safe.
+ *  Any time a buffer has to grow it's counted, which should stay at zero during normal play.
+ *  Use "stat TraceBuffers" to see buffer growths per frame.
+ */
+UCLASS()
+class UTraceBufferSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	friend class FScopedHitBuffer;
+
+	/** Pooled buffers. Indirect so buffers in use stay put when the pool grows */
+	TIndirectArray<TArray<FHitResult>> HitBuffers;
+
+	/** Number of buffers currently handed out */
+	int32 NumHitBuffersInUse = 0;
+
+	/** Total buffer growths and new buffers since the world started */
+	uint32 NumGrowths = 0;
+
+public:
+
+	/** Hit capacity of each pooled buffer when it's created */
+	static constexpr int32 InitialHitCapacity = 32;
+
+	/** Number of buffers created up front. Covers a trace nested inside another trace's hit handling */
+	static constexpr int32 InitialNumHitBuffers = 2;
+
+	/** Returns the number of buffer growths since the world started */
+	uint32 GetNumGrowths() const { return NumGrowths; }
+
+protected:
+
+	/** Hands out the next free buffer, emptied */
+	TArray<FHitResult>& AcquireHitBuffer();
+
+	/** Returns the most recently acquired buffer to the pool and counts any growth */
+	void ReleaseHitBuffer(TArray<FHitResult>& Buffer, int32 AcquiredCapacity);
+
+	/** Adds a buffer to the pool */
+	void AddHitBuffer();
+
+public:
+
+	/** Creates the initial buffers */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	/** Only run in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
+
+/**
+ *  Scoped hit result buffer borrowed from the world's trace buffer pool.
+ *  Falls back to a local array if the world has no pool, such as in editor worlds.
+ */
+class FScopedHitBuffer
+{
+	/** Pool the buffer was borrowed from, if any */
+	UTraceBufferSubsystem* Pool = nullptr;
+
+	/** Buffer in use */
+	TArray<FHitResult>* Buffer = nullptr;
+
+	/** Capacity of the buffer when it was borrowed */
+	int32 AcquiredCapacity = 0;
+
+	/** Fallback buffer when there's no pool */
+	TArray<FHitResult> LocalBuffer;
+
+public:
+
+	explicit FScopedHitBuffer(const UWorld* World);
+	~FScopedHitBuffer();
+
+	FScopedHitBuffer(const FScopedHitBuffer&) = delete;
+	FScopedHitBuffer& operator=(const FScopedHitBuffer&) = delete;
+
+	/** Access to the buffer */
+	TArray<FHitResult>& operator*() const { return *Buffer; }
+	TArray<FHitResult>* operator->() const { return Buffer; }
+};
@@ -8,11 +8,19 @@
 #include "Components/WidgetComponent.h"
 #include "Engine/DamageEvents.h"
 #include "CombatLifeBar.h"
-#include "TimerManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
-
-ACombatEnemy::ACombatEnemy()
+#include "CombatHitStopSubsystem.h"
+#include "CombatTeams.h"
+#include "MyProjectCollisionChannels.h"
+#include "TraceBufferSubsystem.h"
+#include "AnimationBudgetSubsystem.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "CombatCheckpointSubsystem.h"
+#include "BrainComponent.h"
+
+ACombatEnemy::ACombatEnemy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -35,6 +43,13 @@ ACombatEnemy::ACombatEnemy()
 	// set the collision capsule size
 	GetCapsuleComponent()->SetCapsuleSize(35.0f, 90.0f);
 
+	// put the capsule and mesh on the enemy channel so enemy sweeps for pawns skip other enemies
+	GetCapsuleComponent()->SetCollisionProfileName(FName("CombatEnemy"));
+	GetMesh()->SetCollisionObjectType(ECC_CombatEnemy);
+
+	// join the enemy team
+	TeamId = CombatTeams::Enemy;
+
 	// set the character movement properties
 	GetCharacterMovement()->bUseControllerDesiredRotation = true;
 
@@ -51,7 +66,7 @@ void ACombatEnemy::DoAIComboAttack()
 	}
 
 	// raise the attacking flag
-	bIsAttacking = true;
+	SetAttacking(true);
 
 	// choose how many times we're going to attack
 	TargetComboCount = FMath::RandRange(1, ComboSectionNames.Num() - 1);
@@ -82,7 +97,7 @@ void ACombatEnemy::DoAIChargedAttack()
 	}
 
 	// raise the attacking flag
-	bIsAttacking = true;
+	SetAttacking(true);
 
 	// choose how many loops are we going to charge for
 	TargetChargeLoops = FMath::RandRange(MinChargeLoops, MaxChargeLoops);
@@ -107,7 +122,7 @@ void ACombatEnemy::DoAIChargedAttack()
 void ACombatEnemy::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
 	// reset the attacking flag
-	bIsAttacking = false;
+	SetAttacking(false);
 
 	// call the attack completed delegate so the StateTree can continue execution
 	OnAttackCompleted.ExecuteIfBound();
@@ -125,16 +140,17 @@ float ACombatEnemy::GetLastDangerTime() const
 
 void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	// sweep for objects in front of the character to be hit by the attack.
+	// The hit buffer is borrowed from the world pool, so the sweep doesn't allocate
+	FScopedHitBuffer OutHits(GetWorld());
 
 	// start at the provided socket location, sweep forward
 	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
 	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
 
-	// enemies only affect Pawn collision objects; they don't knock back boxes
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	// enemies only affect Pawn collision objects; they don't knock back boxes.
+	// Other enemies are on their own object channel, so they're never returned
+	const FCollisionObjectQueryParams ObjectParams = GetAttackObjectTypes();
 
 	// use a sphere shape for the sweep
 	FCollisionShape CollisionShape;
@@ -144,31 +160,52 @@ void ACombatEnemy::DoAttackTrace(FName DamageSourceBone)
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(this);
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	if (GetWorld()->SweepMultiByObjectType(*OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
 	{
 		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		for (const FHitResult& CurrentHit : *OutHits)
 		{
-			/** does the actor have the player tag? */
-			if (CurrentHit.GetActor()->ActorHasTag(FName("Player")))
-			{
-				// check if the actor is damageable
-				ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
-
-				if (Damageable)
-				{
-					// knock upwards and away from the impact normal
-					const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
-
-					// pass the damage event to the actor
-					Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
-
-				}
-			}
+			ApplyAttackHit(CurrentHit);
 		}
 	}
 }
 
+FCollisionObjectQueryParams ACombatEnemy::GetAttackObjectTypes() const
+{
+	return MyProjectCollision::EnemyAttackObjects();
+}
+
+void ACombatEnemy::ApplyAttackHit(const FHitResult& Hit)
+{
+	// only damage hostile pawns
+	AActor* HitActor = Hit.GetActor();
+
+	if (!HitActor || GetTeamAttitudeTowards(*HitActor) != ETeamAttitude::Hostile)
+	{
+		return;
+	}
+
+	// check if the actor is damageable
+	ICombatDamageable* Damageable = Cast<ICombatDamageable>(HitActor);
+
+	if (!Damageable)
+	{
+		return;
+	}
+
+	// knock upwards and away from the impact normal
+	const FVector Impulse = (Hit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+
+	// pass the damage event to the actor
+	Damageable->ApplyDamage(MeleeDamage, this, Hit.ImpactPoint, Impulse);
+
+	// freeze both of us for a few frames to sell the impact
+	if (UCombatHitStopSubsystem* HitStop = GetWorld()->GetSubsystem<UCombatHitStopSubsystem>())
+	{
+		HitStop->ApplyHitStop(this, HitActor, HitStopFrames, HitStopTimeDilation);
+	}
+}
+
 void ACombatEnemy::CheckCombo()
 {
 	// increase the combo counter
@@ -247,7 +284,10 @@ void ACombatEnemy::HandleDeath()
 	OnEnemyDied.Broadcast();
 
 	// set up the death timer
-	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &ACombatEnemy::RemoveFromLevel, DeathRemovalTime);
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Reschedule(DeathTimer, this, DeathRemovalTime, &ACombatEnemy::RemoveFromLevel);
+	}
 }
 
 void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
@@ -257,8 +297,8 @@ void ACombatEnemy::ApplyHealing(float Healing, AActor* Healer)
 
 void ACombatEnemy::NotifyDanger(const FVector& DangerLocation, AActor* DangerSource)
 {
-	// ensure we're being attacked by the player
-	if (DangerSource && DangerSource->ActorHasTag(FName("Player")))
+	// ensure we're being attacked by a hostile team
+	if (DangerSource && GetTeamAttitudeTowards(*DangerSource) == ETeamAttitude::Hostile)
 	{
 		// save the danger location and game time
 		LastDangerLocation = DangerLocation;
@@ -266,10 +306,129 @@ void ACombatEnemy::NotifyDanger(const FVector& DangerLocation, AActor* DangerSou
 	}
 }
 
+FGenericTeamId ACombatEnemy::GetGenericTeamId() const
+{
+	return TeamId;
+}
+
 void ACombatEnemy::RemoveFromLevel()
 {
-	// destroy this actor
-	Destroy();
+	// stop the ragdoll and hide the character. We stay around so we can be revived without spawning a new actor
+	GetMesh()->SetSimulatePhysics(false);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	// stop running AI logic while deactivated
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->StopLogic(TEXT("Removed from level"));
+		}
+	}
+}
+
+void ACombatEnemy::ReviveAt(const FTransform& Transform, float HP)
+{
+	// cancel any pending removal
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Cancel(DeathTimer);
+	}
+
+	CurrentHP = FMath::Clamp(HP, 0.0f, MaxHP);
+
+	// stop any attack in progress
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->Montage_Stop(0.0f);
+	}
+
+	SetAttacking(false);
+
+	// undo the ragdoll and snap the mesh back onto the capsule
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	GetMesh()->SetRelativeTransform(MeshRelativeTransform);
+
+	// restore collision and movement
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// refill the life bar
+	LifeBar->SetHiddenInGame(false);
+	LifeBarWidget->SetLifePercentage(CurrentHP / MaxHP);
+
+	// restart the AI from its initial state
+	if (AAIController* AIController = Cast<AAIController>(GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
+}
+
+void ACombatEnemy::SaveCheckpointState(FArchive& Ar)
+{
+	FTransform Transform = GetActorTransform();
+
+	Ar << CurrentHP;
+	Ar << Transform;
+}
+
+void ACombatEnemy::LoadCheckpointState(FArchive& Ar)
+{
+	float SavedHP = 0.0f;
+	FTransform Transform;
+
+	Ar << SavedHP;
+	Ar << Transform;
+
+	if (SavedHP > 0.0f)
+	{
+		ReviveAt(Transform, SavedHP);
+
+	} else {
+
+		RestoreMissingCheckpointState();
+	}
+}
+
+void ACombatEnemy::RestoreMissingCheckpointState()
+{
+	// we were dead or didn't exist at the checkpoint, so deactivate right away
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Cancel(DeathTimer);
+	}
+
+	CurrentHP = 0.0f;
+	LifeBar->SetHiddenInGame(true);
+
+	RemoveFromLevel();
+}
+
+void ACombatEnemy::SetAttacking(bool bAttacking)
+{
+	bIsAttacking = bAttacking;
+
+	// never skip animation ticks while attacking
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->SetFullRate(GetMesh(), bAttacking);
+	}
 }
 
 float ACombatEnemy::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -332,12 +491,41 @@ void ACombatEnemy::BeginPlay()
 
 	// fill the life bar
 	LifeBarWidget->SetLifePercentage(1.0f);
+
+	// save the mesh placement so we can reattach it after ragdolling
+	MeshRelativeTransform = GetMesh()->GetRelativeTransform();
+
+	// let checkpoints save and restore our state
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->RegisterActor(this);
+	}
+
+	// let the animation budget throttle our mesh based on significance
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->RegisterMesh(GetMesh());
+	}
 }
 
 void ACombatEnemy::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the death timer
-	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	// cancel the death timer
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->CancelAll(this);
+	}
+
+	// stop tracking our mesh's significance
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->UnregisterMesh(GetMesh());
+	}
+
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->UnregisterActor(this);
+	}
 }
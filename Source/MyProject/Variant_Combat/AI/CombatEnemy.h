@@ -6,8 +6,10 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "CombatCheckpointable.h"
+#include "GenericTeamAgentInterface.h"
 #include "Animation/AnimMontage.h"
-#include "Engine/TimerHandle.h"
+#include "GameplaySchedulerSubsystem.h"
 #include "CombatEnemy.generated.h"
 
 class UWidgetComponent;
@@ -26,9 +28,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEnemyDied);
 /**
  *  An AI-controlled character with combat capabilities.
  *  Its bundled AI Controller runs logic through StateTree
+ *  Dead enemies are deactivated rather than destroyed, so spawners and checkpoints can revive them in place
  */
 UCLASS(abstract)
-class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDamageable
+class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDamageable, public IGenericTeamAgentInterface, public ICombatCheckpointable
 {
 	GENERATED_BODY()
 
@@ -38,8 +41,8 @@ class ACombatEnemy : public ACharacter, public ICombatAttacker, public ICombatDa
 
 public:
 	
-	/** Constructor */
-	ACombatEnemy();
+	/** Constructor. Uses a budgeted skeletal mesh so animation can be throttled by the animation budget allocator */
+	ACombatEnemy(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
@@ -55,6 +58,10 @@ public:
 
 protected:
 
+	/** Team this character belongs to. Characters on other teams are treated as hostile */
+	UPROPERTY(EditAnywhere, Category="Team")
+	FGenericTeamId TeamId;
+
 	/** Name of the pelvis bone, for damage ragdoll physics */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	FName PelvisBoneName;
@@ -86,6 +93,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm/s"))
 	float MeleeLaunchImpulse = 350.0f;
 
+	/** Number of frames the attacker and victim freeze for when a melee attack connects. 0 disables hit-stop */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Hit Stop", meta = (ClampMin = 0, ClampMax = 30))
+	int32 HitStopFrames = 3;
+
+	/** Time dilation applied to the attacker and victim during hit-stop */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Hit Stop", meta = (ClampMin = 0, ClampMax = 1))
+	float HitStopTimeDilation = 0.01f;
+
 	/** AnimMontage that will play for combo attacks */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
 	UAnimMontage* ComboAttackMontage;
@@ -131,7 +146,7 @@ protected:
 	float DeathRemovalTime = 5.0f;
 
 	/** Enemy death timer */
-	FTimerHandle DeathTimer;
+	FGameplayScheduleHandle DeathTimer;
 
 	/** Attack montage ended delegate */
 	FOnMontageEnded OnAttackMontageEnded;
@@ -142,6 +157,9 @@ protected:
 	/** Last recorded game time we were attacked */
 	float LastDangerTime = -1000.0f;
 
+	/** Mesh transform relative to the capsule, used to reattach the mesh after ragdolling */
+	FTransform MeshRelativeTransform;
+
 public:
 	/** Attack completed internal delegate to notify StateTree tasks */
 	FOnEnemyAttackCompleted OnAttackCompleted;
@@ -170,6 +188,15 @@ public:
 	/** Returns the last game time we were attacked */
 	float GetLastDangerTime() const;
 
+	/** Returns the max HP the character respawns with */
+	float GetMaxHP() const { return MaxHP; }
+
+	/** Returns true if the character has died */
+	bool IsDead() const { return CurrentHP <= 0.0f; }
+
+	/** Brings the character back to life at the transform with the provided HP, clearing any ragdoll and restarting its AI */
+	void ReviveAt(const FTransform& Transform, float HP);
+
 public:
 
 	// ~begin ICombatAttacker interface
@@ -185,6 +212,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckChargedAttack() override;
 
+	/** Returns the collision object types our hitboxes can hit */
+	virtual FCollisionObjectQueryParams GetAttackObjectTypes() const override;
+
+	/** Applies damage, knockback and hit-stop to a target hit by an attack */
+	virtual void ApplyAttackHit(const FHitResult& Hit) override;
+
 	// ~end ICombatAttacker interface
 
 	// ~begin ICombatDamageable interface
@@ -203,11 +236,34 @@ public:
 
 	// ~end ICombatDamageable interface
 
+	// ~begin IGenericTeamAgentInterface
+
+	/** Returns the team this character belongs to */
+	virtual FGenericTeamId GetGenericTeamId() const override;
+
+	// ~end IGenericTeamAgentInterface
+
+	// ~begin ICombatCheckpointable interface
+
+	/** Saves HP and transform */
+	virtual void SaveCheckpointState(FArchive& Ar) override;
+
+	/** Revives or removes the character to match the checkpoint */
+	virtual void LoadCheckpointState(FArchive& Ar) override;
+
+	/** Removes characters spawned after the checkpoint */
+	virtual void RestoreMissingCheckpointState() override;
+
+	// ~end ICombatCheckpointable interface
+
 protected:
 
-	/** Removes this character from the level after it dies */
+	/** Removes this character from the level after it dies. The character is hidden and deactivated, but not destroyed */
 	void RemoveFromLevel();
 
+	/** Sets the attacking flag and keeps animation at full rate while attacking, so attack notifies stay frame accurate */
+	void SetAttacking(bool bAttacking);
+
 public:
 
 	/** Overrides the default TakeDamage functionality */
@@ -6,8 +6,9 @@
 #include "Components/SceneComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/ArrowComponent.h"
-#include "TimerManager.h"
 #include "CombatEnemy.h"
+#include "CombatWaveDirectorSubsystem.h"
+#include "CombatCheckpointSubsystem.h"
 
 ACombatEnemySpawner::ACombatEnemySpawner()
 {
@@ -31,12 +32,27 @@ ACombatEnemySpawner::ACombatEnemySpawner()
 void ACombatEnemySpawner::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	// let the wave director manage our spawns
+	if (UCombatWaveDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatWaveDirectorSubsystem>())
+	{
+		Director->RegisterSpawner(this);
+	}
+
+	// let checkpoints save and restore our state
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->RegisterActor(this);
+	}
+
 	// should we spawn an enemy right away?
 	if (bShouldSpawnEnemiesImmediately)
 	{
 		// schedule the first enemy spawn
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, InitialSpawnDelay);
+		if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+		{
+			Scheduler->Reschedule(SpawnTimer, this, InitialSpawnDelay, &ACombatEnemySpawner::SpawnEnemy);
+		}
 	}
 
 }
@@ -45,32 +61,77 @@ void ACombatEnemySpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the spawn timer
-	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+	// cancel any pending spawns
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->CancelAll(this);
+	}
+
+	if (UCombatWaveDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatWaveDirectorSubsystem>())
+	{
+		Director->UnregisterSpawner(this);
+	}
+
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->UnregisterActor(this);
+	}
 }
 
 void ACombatEnemySpawner::SpawnEnemy()
 {
+	// queue the spawn so the director can budget it against other spawners
+	if (UCombatWaveDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatWaveDirectorSubsystem>())
+	{
+		Director->RequestSpawn(this);
+
+	} else {
+
+		SpawnQueuedEnemy();
+	}
+}
+
+ACombatEnemy* ACombatEnemySpawner::SpawnQueuedEnemy()
+{
+	// revive our last enemy instead of spawning a new actor
+	if (IsValid(CurrentEnemy) && CurrentEnemy->IsDead())
+	{
+		CurrentEnemy->ReviveAt(SpawnCapsule->GetComponentTransform(), CurrentEnemy->GetMaxHP());
+		return CurrentEnemy;
+	}
+
 	// ensure the enemy class is valid
-	if (IsValid(EnemyClass))
+	if (!IsValid(EnemyClass))
 	{
-		// spawn the enemy at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		return nullptr;
+	}
 
-		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+	// spawn the enemy at the reference capsule's transform
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-		// was the enemy successfully created?
-		if (SpawnedEnemy)
-		{
-			// subscribe to the death delegate
-			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
-		}
+	ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+
+	// was the enemy successfully created?
+	if (SpawnedEnemy)
+	{
+		// subscribe to the death delegate
+		SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+
+		CurrentEnemy = SpawnedEnemy;
 	}
+
+	return SpawnedEnemy;
 }
 
 void ACombatEnemySpawner::OnEnemyDied()
 {
+	// free up the enemy's slot under the live cap
+	if (UCombatWaveDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatWaveDirectorSubsystem>())
+	{
+		Director->NotifyEnemyDied(this);
+	}
+
 	// decrease the spawn counter
 	--SpawnCount;
 
@@ -78,16 +139,24 @@ void ACombatEnemySpawner::OnEnemyDied()
 	if (SpawnCount <= 0)
 	{
 		// schedule the activation on depleted message
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnerDepleted, ActivationDelay);
+		if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+		{
+			Scheduler->Reschedule(SpawnTimer, this, ActivationDelay, &ACombatEnemySpawner::SpawnerDepleted);
+		}
 		return;
 	}
 
 	// schedule the next enemy spawn
-	GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, RespawnDelay);
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Reschedule(SpawnTimer, this, RespawnDelay, &ACombatEnemySpawner::SpawnEnemy);
+	}
 }
 
 void ACombatEnemySpawner::SpawnerDepleted()
 {
+	bHasBeenDepleted = true;
+
 	// process the actors to activate list
 	for (AActor* CurrentActor : ActorsToActivateWhenDepleted)
 	{
@@ -124,3 +193,53 @@ void ACombatEnemySpawner::DeactivateInteraction(AActor* ActivationInstigator)
 {
 	// stub
 }
+
+void ACombatEnemySpawner::SaveCheckpointState(FArchive& Ar)
+{
+	Ar << SpawnCount;
+	Ar << bHasBeenActivated;
+	Ar << bHasBeenDepleted;
+}
+
+void ACombatEnemySpawner::LoadCheckpointState(FArchive& Ar)
+{
+	Ar << SpawnCount;
+	Ar << bHasBeenActivated;
+	Ar << bHasBeenDepleted;
+}
+
+void ACombatEnemySpawner::PostCheckpointRestored()
+{
+	// drop anything we had scheduled after the checkpoint
+	UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>();
+
+	if (Scheduler)
+	{
+		Scheduler->Cancel(SpawnTimer);
+	}
+
+	// our enemy has already been revived or removed to match the checkpoint
+	ACombatEnemy* LiveEnemy = (IsValid(CurrentEnemy) && !CurrentEnemy->IsDead()) ? CurrentEnemy.Get() : nullptr;
+
+	if (UCombatWaveDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatWaveDirectorSubsystem>())
+	{
+		Director->ResetSpawner(this, LiveEnemy);
+	}
+
+	// nothing else to do if our enemy is alive, or we haven't started spawning yet
+	if (LiveEnemy || !(bShouldSpawnEnemiesImmediately || bHasBeenActivated) || !Scheduler)
+	{
+		return;
+	}
+
+	if (SpawnCount > 0)
+	{
+		// schedule the next enemy spawn
+		Scheduler->Reschedule(SpawnTimer, this, RespawnDelay, &ACombatEnemySpawner::SpawnEnemy);
+
+	} else if (!bHasBeenDepleted) {
+
+		// the last enemy died right before the checkpoint, so finish the depletion
+		Scheduler->Reschedule(SpawnTimer, this, ActivationDelay, &ACombatEnemySpawner::SpawnerDepleted);
+	}
+}
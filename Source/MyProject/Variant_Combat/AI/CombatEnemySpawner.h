@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatActivatable.h"
+#include "CombatCheckpointable.h"
+#include "GameplaySchedulerSubsystem.h"
 #include "CombatEnemySpawner.generated.h"
 
 class UCapsuleComponent;
@@ -14,6 +16,7 @@ class ACombatEnemy;
 /**
  *  A basic Actor in charge of spawning Enemy Characters and monitoring their deaths.
  *  Enemies will be spawned one by one, and the spawner will wait until the enemy dies before spawning a new one.
+ *  Spawns are queued with the wave director, which decides on which frame they actually happen.
  *  The spawner can be remotely activated through the ICombatActivatable interface
  *  When the last spawned enemy dies, the spawner can also activate other ICombatActivatables
  */
@@ -46,6 +49,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 100))
 	int32 SpawnCount = 1;
 
+	/** Relative cost of spawning this enemy type, counted against the wave director's per-frame spawn budget */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0.1, ClampMax = 10))
+	float SpawnCost = 1.0f;
+
 	/** Time to wait before spawning the next enemy after the current one dies */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float RespawnDelay = 5.0f;
@@ -61,8 +68,15 @@ protected:
 	/** Flag to ensure this is only activated once */
 	bool bHasBeenActivated = false;
 
+	/** Set once the actor list has been activated after the last enemy died */
+	bool bHasBeenDepleted = false;
+
+	/** Last enemy spawned. Revived for the next spawn once it dies */
+	UPROPERTY()
+	TObjectPtr<ACombatEnemy> CurrentEnemy;
+
 	/** Timer to spawn enemies after a delay */
-	FTimerHandle SpawnTimer;
+	FGameplayScheduleHandle SpawnTimer;
 
 public:	
 	
@@ -79,7 +93,7 @@ public:
 
 protected:
 
-	/** Spawn an enemy and subscribe to its death event */
+	/** Queues an enemy spawn with the wave director */
 	void SpawnEnemy();
 
 	/** Called when the spawned enemy has died */
@@ -89,6 +103,14 @@ protected:
 	/** Called after the last spawned enemy has died */
 	void SpawnerDepleted();
 
+public:
+
+	/** Spawns an enemy and subscribes to its death event. Called by the wave director when the queued spawn is served */
+	ACombatEnemy* SpawnQueuedEnemy();
+
+	/** Returns the spawn cost for this spawner's enemy type */
+	float GetSpawnCost() const { return SpawnCost; }
+
 public:
 
 	// ~begin ICombatActivatable interface
@@ -106,4 +128,17 @@ public:
 	virtual void DeactivateInteraction(AActor* ActivationInstigator) override;
 
 	// ~end IActivatable interface
+
+	// ~begin ICombatCheckpointable interface
+
+	/** Saves the remaining spawn count and activation state */
+	virtual void SaveCheckpointState(FArchive& Ar) override;
+
+	/** Restores the remaining spawn count and activation state */
+	virtual void LoadCheckpointState(FArchive& Ar) override;
+
+	/** Reschedules spawns once our enemy has been restored */
+	virtual void PostCheckpointRestored() override;
+
+	// ~end ICombatCheckpointable interface
 };
@@ -0,0 +1,402 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatFlowFieldSubsystem.h"
+#include "CombatFlowFieldVolume.h"
+#include "Components/BoxComponent.h"
+#include "NavigationSystem.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "DrawDebugHelpers.h"
+#include "Stats/Stats.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Flow Field Update"), STAT_CombatFlowFieldUpdate, STATGROUP_Game);
+
+namespace CombatFlowField
+{
+	static TAutoConsoleVariable<bool> CVarDebugDraw(
+		TEXT("MyProject.FlowField.Debug"),
+		false,
+		TEXT("If true, draws the direction of every reachable flow field cell"),
+		ECVF_Cheat);
+
+	/** Largest grid dimension supported on each axis */
+	static constexpr int32 MaxGridSize = 1024;
+}
+
+const FIntPoint UCombatFlowFieldSubsystem::NeighborOffsets[8] =
+{
+	FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+	FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+};
+
+int32 UCombatFlowFieldSubsystem::FFlowField::GetCellIndex(const FVector& Location) const
+{
+	const int32 X = FMath::FloorToInt32((Location.X - Origin.X) / CellSize);
+	const int32 Y = FMath::FloorToInt32((Location.Y - Origin.Y) / CellSize);
+
+	if (X < 0 || Y < 0 || X >= SizeX || Y >= SizeY)
+	{
+		return INDEX_NONE;
+	}
+
+	return Y * SizeX + X;
+}
+
+FVector UCombatFlowFieldSubsystem::FFlowField::GetCellLocation(int32 Cell) const
+{
+	return FVector(Origin.X + ((Cell % SizeX) + 0.5f) * CellSize, Origin.Y + ((Cell / SizeX) + 0.5f) * CellSize, CellHeights[Cell]);
+}
+
+bool UCombatFlowFieldSubsystem::FFlowField::AreConnected(int32 From, int32 To) const
+{
+	return Walkable[From] && Walkable[To] && FMath::Abs(CellHeights[From] - CellHeights[To]) <= MaxStepHeight;
+}
+
+bool UCombatFlowFieldSubsystem::FFlowField::CanStep(int32 Cell, int32 X, int32 Y, int32 DirectionIndex) const
+{
+	// orthogonal steps can't cut corners
+	if (DirectionIndex < 4)
+	{
+		return true;
+	}
+
+	const int32 NX = X + NeighborOffsets[DirectionIndex].X;
+	const int32 NY = Y + NeighborOffsets[DirectionIndex].Y;
+
+	return AreConnected(Cell, Y * SizeX + NX) && AreConnected(Cell, NY * SizeX + X);
+}
+
+void UCombatFlowFieldSubsystem::RegisterArena(ACombatFlowFieldVolume* Volume)
+{
+	if (!Volume || FlowFields.ContainsByPredicate([Volume](const FFlowField& Field) { return Field.Volume.Get() == Volume; }))
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!NavSys)
+	{
+		return;
+	}
+
+	// the grid is axis aligned over the box's XY bounds
+	const FVector Center = Volume->GetBox()->GetComponentLocation();
+	const FVector Extent = Volume->GetBox()->GetScaledBoxExtent();
+
+	FFlowField& Field = FlowFields.AddDefaulted_GetRef();
+	Field.Volume = Volume;
+	Field.CellSize = Volume->GetCellSize();
+	Field.MaxStepHeight = Volume->GetMaxStepHeight();
+	Field.MaxCellsPerFrame = Volume->GetMaxCellsPerFrame();
+	Field.Origin = FVector(Center.X - Extent.X, Center.Y - Extent.Y, Center.Z);
+	Field.SizeX = FMath::Clamp(FMath::CeilToInt32(2.0f * Extent.X / Field.CellSize), 1, CombatFlowField::MaxGridSize);
+	Field.SizeY = FMath::Clamp(FMath::CeilToInt32(2.0f * Extent.Y / Field.CellSize), 1, CombatFlowField::MaxGridSize);
+
+	const int32 NumCells = Field.SizeX * Field.SizeY;
+
+	Field.CellHeights.SetNumZeroed(NumCells);
+	Field.Walkable.Init(false, NumCells);
+	Field.Distances.Init(Unreachable, NumCells);
+	Field.Directions.Init(NoDirection, NumCells);
+
+	// project every cell center onto the navmesh once. Walkability doesn't change during play
+	const FVector ProjectionExtent(Field.CellSize * 0.5f, Field.CellSize * 0.5f, Extent.Z);
+
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		const FVector CellCenter(Field.Origin.X + ((Cell % Field.SizeX) + 0.5f) * Field.CellSize, Field.Origin.Y + ((Cell / Field.SizeX) + 0.5f) * Field.CellSize, Center.Z);
+
+		FNavLocation NavLocation;
+
+		if (NavSys->ProjectPointToNavigation(CellCenter, NavLocation, ProjectionExtent))
+		{
+			Field.Walkable[Cell] = true;
+			Field.CellHeights[Cell] = NavLocation.Location.Z;
+		}
+	}
+}
+
+void UCombatFlowFieldSubsystem::UnregisterArena(ACombatFlowFieldVolume* Volume)
+{
+	FlowFields.RemoveAllSwap([Volume](const FFlowField& Field) { return Field.Volume.Get() == Volume; });
+}
+
+bool UCombatFlowFieldSubsystem::SampleDirection(const FVector& Location, FVector& OutDirection) const
+{
+	const FFlowField* Field = FindFlowField(Location);
+
+	if (!Field)
+	{
+		return false;
+	}
+
+	const int32 Cell = Field->GetCellIndex(Location);
+	const uint16 Distance = Field->Distances[Cell];
+
+	if (Distance == Unreachable)
+	{
+		return false;
+	}
+
+	// head straight for the goal once we're next to it
+	if (Distance <= 1)
+	{
+		OutDirection = (Field->GoalLocation - Location).GetSafeNormal2D();
+		return true;
+	}
+
+	const uint8 Direction = Field->Directions[Cell];
+
+	if (Direction == NoDirection)
+	{
+		return false;
+	}
+
+	OutDirection = FVector(NeighborOffsets[Direction].X, NeighborOffsets[Direction].Y, 0.0f).GetSafeNormal();
+	return true;
+}
+
+const UCombatFlowFieldSubsystem::FFlowField* UCombatFlowFieldSubsystem::FindFlowField(const FVector& Location) const
+{
+	// there are only a handful of arenas, so a linear search is fine
+	for (const FFlowField& Field : FlowFields)
+	{
+		if (Field.GoalCell != INDEX_NONE && Field.GetCellIndex(Location) != INDEX_NONE)
+		{
+			return &Field;
+		}
+	}
+
+	return nullptr;
+}
+
+void UCombatFlowFieldSubsystem::BeginBuild(FFlowField& Field, int32 GoalCell, const FVector& GoalLocation)
+{
+	Field.BuildGoalCell = GoalCell;
+	Field.BuildGoalLocation = GoalLocation;
+
+	// start a breadth-first wave from the goal
+	Field.BuildDistances.Init(Unreachable, Field.SizeX * Field.SizeY);
+	Field.BuildDistances[GoalCell] = 0;
+
+	Field.BuildQueue.Reset();
+	Field.BuildQueue.Add(GoalCell);
+	Field.BuildQueueHead = 0;
+
+	Field.BuildDirections.SetNumUninitialized(Field.SizeX * Field.SizeY);
+	Field.BuildDirectionCell = 0;
+}
+
+bool UCombatFlowFieldSubsystem::ContinueBuild(FFlowField& Field)
+{
+	int32 NumProcessed = 0;
+
+	while (Field.BuildQueueHead < Field.BuildQueue.Num() && NumProcessed < Field.MaxCellsPerFrame)
+	{
+		const int32 Cell = Field.BuildQueue[Field.BuildQueueHead++];
+		const int32 X = Cell % Field.SizeX;
+		const int32 Y = Cell / Field.SizeX;
+		const uint16 NextDistance = FMath::Min<uint16>(Field.BuildDistances[Cell] + 1, Unreachable - 1);
+
+		for (int32 i = 0; i < UE_ARRAY_COUNT(NeighborOffsets); ++i)
+		{
+			const int32 NX = X + NeighborOffsets[i].X;
+			const int32 NY = Y + NeighborOffsets[i].Y;
+
+			if (NX < 0 || NY < 0 || NX >= Field.SizeX || NY >= Field.SizeY)
+			{
+				continue;
+			}
+
+			const int32 Neighbor = NY * Field.SizeX + NX;
+
+			if (Field.BuildDistances[Neighbor] != Unreachable || !Field.AreConnected(Cell, Neighbor))
+			{
+				continue;
+			}
+
+			// don't cut corners around blocked cells
+			if (!Field.CanStep(Cell, X, Y, i))
+			{
+				continue;
+			}
+
+			Field.BuildDistances[Neighbor] = NextDistance;
+			Field.BuildQueue.Add(Neighbor);
+		}
+
+		++NumProcessed;
+	}
+
+	// derive directions with the rest of the frame's budget once the distances are final
+	if (Field.BuildQueueHead < Field.BuildQueue.Num())
+	{
+		return false;
+	}
+
+	const int32 NumCells = Field.BuildDistances.Num();
+
+	while (Field.BuildDirectionCell < NumCells && NumProcessed < Field.MaxCellsPerFrame)
+	{
+		Field.BuildDirections[Field.BuildDirectionCell] = BuildDirection(Field, Field.BuildDirectionCell);
+
+		++Field.BuildDirectionCell;
+		++NumProcessed;
+	}
+
+	return Field.BuildDirectionCell >= NumCells;
+}
+
+uint8 UCombatFlowFieldSubsystem::BuildDirection(const FFlowField& Field, int32 Cell)
+{
+	const uint16 Distance = Field.BuildDistances[Cell];
+
+	if (Distance == Unreachable || Distance == 0)
+	{
+		return NoDirection;
+	}
+
+	const int32 X = Cell % Field.SizeX;
+	const int32 Y = Cell / Field.SizeX;
+	const FVector2f ToGoal = FVector2f((Field.BuildGoalCell % Field.SizeX) - X, (Field.BuildGoalCell / Field.SizeX) - Y).GetSafeNormal();
+
+	uint8 BestDirection = NoDirection;
+	uint16 BestDistance = Unreachable;
+	float BestAlignment = -2.0f;
+
+	// point the cell at its closest neighbor to the goal
+	for (int32 i = 0; i < UE_ARRAY_COUNT(NeighborOffsets); ++i)
+	{
+		const int32 NX = X + NeighborOffsets[i].X;
+		const int32 NY = Y + NeighborOffsets[i].Y;
+
+		if (NX < 0 || NY < 0 || NX >= Field.SizeX || NY >= Field.SizeY)
+		{
+			continue;
+		}
+
+		const int32 Neighbor = NY * Field.SizeX + NX;
+		const uint16 NeighborDistance = Field.BuildDistances[Neighbor];
+
+		if (NeighborDistance >= Distance || !Field.AreConnected(Cell, Neighbor) || !Field.CanStep(Cell, X, Y, i))
+		{
+			continue;
+		}
+
+		// break ties by how straight the step points at the goal, to avoid zig-zagging
+		const float Alignment = FVector2f(NeighborOffsets[i].X, NeighborOffsets[i].Y).GetSafeNormal() | ToGoal;
+
+		if (NeighborDistance < BestDistance || (NeighborDistance == BestDistance && Alignment > BestAlignment))
+		{
+			BestDistance = NeighborDistance;
+			BestAlignment = Alignment;
+			BestDirection = static_cast<uint8>(i);
+		}
+	}
+
+	return BestDirection;
+}
+
+void UCombatFlowFieldSubsystem::FinishBuild(FFlowField& Field)
+{
+	// the built field becomes the sampled field
+	Swap(Field.Distances, Field.BuildDistances);
+	Swap(Field.Directions, Field.BuildDirections);
+
+	Field.GoalCell = Field.BuildGoalCell;
+	Field.GoalLocation = Field.BuildGoalLocation;
+	Field.BuildGoalCell = INDEX_NONE;
+	Field.BuildQueue.Reset();
+}
+
+void UCombatFlowFieldSubsystem::InvalidateField(FFlowField& Field)
+{
+	Field.GoalCell = INDEX_NONE;
+	Field.BuildGoalCell = INDEX_NONE;
+	Field.BuildQueue.Reset();
+}
+
+void UCombatFlowFieldSubsystem::DrawDebugField(const FFlowField& Field) const
+{
+	for (int32 Cell = 0; Cell < Field.Directions.Num(); ++Cell)
+	{
+		const uint8 Direction = Field.Directions[Cell];
+
+		if (Direction == NoDirection)
+		{
+			continue;
+		}
+
+		const FVector Start = Field.GetCellLocation(Cell) + FVector(0.0f, 0.0f, 10.0f);
+		const FVector End = Start + FVector(NeighborOffsets[Direction].X, NeighborOffsets[Direction].Y, 0.0f).GetSafeNormal() * Field.CellSize * 0.4f;
+
+		DrawDebugDirectionalArrow(GetWorld(), Start, End, 20.0f, FColor::Cyan, false, -1.0f, 0, 2.0f);
+	}
+}
+
+void UCombatFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatFlowFieldUpdate);
+
+	Super::Tick(DeltaTime);
+
+	// drop arenas that went away without unregistering
+	FlowFields.RemoveAllSwap([](const FFlowField& Field) { return !Field.Volume.IsValid(); });
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+	for (FFlowField& Field : FlowFields)
+	{
+		const FVector PlayerLocation = PlayerPawn ? PlayerPawn->GetActorLocation() : FVector::ZeroVector;
+		const int32 PlayerCell = PlayerPawn ? Field.GetCellIndex(PlayerLocation) : INDEX_NONE;
+
+		// the player left the arena, so the field no longer leads anywhere useful
+		if (PlayerCell == INDEX_NONE)
+		{
+			InvalidateField(Field);
+
+		} else if (Field.BuildGoalCell != INDEX_NONE) {
+
+			// keep building towards the last goal
+			if (ContinueBuild(Field))
+			{
+				FinishBuild(Field);
+			}
+
+		} else if (Field.Walkable[PlayerCell]) {
+
+			if (PlayerCell == Field.GoalCell)
+			{
+				// same cell, so only the final approach changes
+				Field.GoalLocation = PlayerLocation;
+
+			} else {
+
+				// the player moved to another cell, so start rebuilding the field
+				BeginBuild(Field, PlayerCell, PlayerLocation);
+			}
+		}
+
+		if (Field.GoalCell != INDEX_NONE && CombatFlowField::CVarDebugDraw.GetValueOnGameThread())
+		{
+			DrawDebugField(Field);
+		}
+	}
+}
+
+TStatId UCombatFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatFlowFieldSubsystem::Deinitialize()
+{
+	FlowFields.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,152 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatFlowFieldSubsystem.generated.h"
+
+class ACombatFlowFieldVolume;
+
+/**
+ *  Maintains one player-centered flow field per combat arena.
+ *  Each field stores the distance from every walkable cell to the player's cell and the direction to step in.
+ *  When the player changes cells, the field is rebuilt over several frames while enemies keep steering
+ *  along the previous one, so the cost of chasing the player doesn't depend on the number of enemies.
+ *  Both the breadth-first pass and the direction pass are time-sliced. While the player is outside
+ *  the arena, the field is invalidated and sampling fails, so enemies fall back to pathfinding.
+ *  Sampling a direction is a constant time lookup.
+ */
+UCLASS()
+class UCombatFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Value for unreachable cells */
+	static constexpr uint16 Unreachable = MAX_uint16;
+
+	/** Value for cells without a direction */
+	static constexpr uint8 NoDirection = MAX_uint8;
+
+	/** Flow field for a single arena */
+	struct FFlowField
+	{
+		/** Arena volume */
+		TWeakObjectPtr<ACombatFlowFieldVolume> Volume;
+
+		/** World location of the min corner of the grid */
+		FVector Origin = FVector::ZeroVector;
+
+		/** Grid dimensions, in cells */
+		int32 SizeX = 0;
+		int32 SizeY = 0;
+
+		/** Cell size and max step height, copied from the volume */
+		float CellSize = 100.0f;
+		float MaxStepHeight = 60.0f;
+
+		/** Cells processed each frame during updates */
+		int32 MaxCellsPerFrame = 2048;
+
+		/** Navmesh height of each cell. Only valid for walkable cells */
+		TArray<float> CellHeights;
+
+		/** Cells with navmesh under them */
+		TBitArray<> Walkable;
+
+		/** Distance in cells to the goal, used for sampling */
+		TArray<uint16> Distances;
+
+		/** Direction index towards the goal for each cell, used for sampling */
+		TArray<uint8> Directions;
+
+		/** Goal cell and location the sampled field leads to */
+		int32 GoalCell = INDEX_NONE;
+		FVector GoalLocation = FVector::ZeroVector;
+
+		/** Distances being built for the next goal */
+		TArray<uint16> BuildDistances;
+
+		/** Directions being built for the next goal */
+		TArray<uint8> BuildDirections;
+
+		/** Breadth-first frontier for the build */
+		TArray<int32> BuildQueue;
+
+		/** Next frontier entry to process */
+		int32 BuildQueueHead = 0;
+
+		/** Next cell to derive a direction for, once the breadth-first pass is done */
+		int32 BuildDirectionCell = 0;
+
+		/** Goal cell and location being built, or INDEX_NONE when idle */
+		int32 BuildGoalCell = INDEX_NONE;
+		FVector BuildGoalLocation = FVector::ZeroVector;
+
+		/** Returns the cell containing the location, or INDEX_NONE */
+		int32 GetCellIndex(const FVector& Location) const;
+
+		/** Returns the world location at the center of the cell, on the navmesh */
+		FVector GetCellLocation(int32 Cell) const;
+
+		/** Returns true if units can step directly between the neighboring cells */
+		bool AreConnected(int32 From, int32 To) const;
+
+		/** Returns true if units can step diagonally without cutting the corners of blocked cells */
+		bool CanStep(int32 Cell, int32 X, int32 Y, int32 DirectionIndex) const;
+	};
+
+	/** Flow fields for all registered arenas */
+	TArray<FFlowField> FlowFields;
+
+public:
+
+	/** Grid offsets for the eight neighbor directions. Orthogonal directions come first */
+	static const FIntPoint NeighborOffsets[8];
+
+	/** Projects the arena's cells onto the navmesh and starts tracking the player */
+	void RegisterArena(ACombatFlowFieldVolume* Volume);
+
+	/** Stops tracking the arena */
+	void UnregisterArena(ACombatFlowFieldVolume* Volume);
+
+	/**
+	 *  Returns the normalized 2D direction towards the player from the location.
+	 *  Returns false if the location isn't covered by a ready flow field, or the player can't be reached from it.
+	 */
+	bool SampleDirection(const FVector& Location, FVector& OutDirection) const;
+
+protected:
+
+	/** Returns the flow field covering the location, or nullptr */
+	const FFlowField* FindFlowField(const FVector& Location) const;
+
+	/** Starts rebuilding the field towards the goal */
+	void BeginBuild(FFlowField& Field, int32 GoalCell, const FVector& GoalLocation);
+
+	/** Advances the breadth-first pass, then derives directions from the distances. Returns true once the build is complete */
+	bool ContinueBuild(FFlowField& Field);
+
+	/** Derives the direction towards the goal for the cell from the built distances */
+	static uint8 BuildDirection(const FFlowField& Field, int32 Cell);
+
+	/** Makes the built field the sampled field */
+	void FinishBuild(FFlowField& Field);
+
+	/** Stops sampling and building the field until the player comes back into the arena */
+	void InvalidateField(FFlowField& Field);
+
+	/** Draws the sampled flow field directions */
+	void DrawDebugField(const FFlowField& Field) const;
+
+public:
+
+	/** Updates flow fields as the player moves */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+};
@@ -8,7 +8,9 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIController.h"
+#include "Navigation/PathFollowingComponent.h"
 #include "CombatEnemy.h"
+#include "CombatFlowFieldSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "StateTreeAsyncExecutionContext.h"
 
@@ -322,4 +324,74 @@ FText FStateTreeGetPlayerInfoTask::GetDescription(const FGuid& ID, FStateTreeDat
 {
 	return FText::FromString("<b>Get Player Info</b>");
 }
-#endif // WITH_EDITOR
\ No newline at end of file
+#endif // WITH_EDITOR
+////////////////////////////////////////////////////////////////////
+
+EStateTreeRunStatus FStateTreeFollowFlowFieldTask::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	if (!InstanceData.Character || !InstanceData.Target)
+	{
+		return EStateTreeRunStatus::Failed;
+	}
+
+	const FVector CharacterLocation = InstanceData.Character->GetActorLocation();
+
+	// are we close enough to the target?
+	if (FVector::Dist2D(CharacterLocation, InstanceData.Target->GetActorLocation()) <= InstanceData.AcceptanceRadius)
+	{
+		return EStateTreeRunStatus::Succeeded;
+	}
+
+	// sample the flow field. This is a single lookup regardless of how many enemies are chasing
+	const UCombatFlowFieldSubsystem* FlowFields = InstanceData.Character->GetWorld()->GetSubsystem<UCombatFlowFieldSubsystem>();
+	const APawn* TargetPawn = Cast<APawn>(InstanceData.Target);
+	FVector FlowDirection;
+
+	if (FlowFields && TargetPawn && TargetPawn->IsPlayerControlled() && FlowFields->SampleDirection(CharacterLocation, FlowDirection))
+	{
+		// stop any fallback path we were following
+		if (InstanceData.bUsingPathfinding && InstanceData.Controller)
+		{
+			InstanceData.Controller->StopMovement();
+			InstanceData.bUsingPathfinding = false;
+		}
+
+		InstanceData.Character->AddMovementInput(FlowDirection);
+
+	} else if (InstanceData.Controller) {
+
+		// not covered by a flow field, so pathfind to the target instead.
+		// Reissue the move if the last one finished or failed before we reached the target
+		if (!InstanceData.bUsingPathfinding || InstanceData.Controller->GetMoveStatus() == EPathFollowingStatus::Idle)
+		{
+			InstanceData.Controller->MoveToActor(InstanceData.Target, InstanceData.AcceptanceRadius);
+			InstanceData.bUsingPathfinding = true;
+		}
+	}
+
+	return EStateTreeRunStatus::Running;
+}
+
+void FStateTreeFollowFlowFieldTask::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	// get the instance data
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+
+	// stop the fallback path
+	if (InstanceData.bUsingPathfinding && InstanceData.Controller)
+	{
+		InstanceData.Controller->StopMovement();
+	}
+
+	InstanceData.bUsingPathfinding = false;
+}
+
+#if WITH_EDITOR
+FText FStateTreeFollowFlowFieldTask::GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting /*= EStateTreeNodeFormatting::Text*/) const
+{
+	return FText::FromString("<b>Follow Flow Field</b>");
+}
+#endif // WITH_EDITOR
@@ -362,4 +362,57 @@ struct FStateTreeGetPlayerInfoTask : public FStateTreeTaskCommonBase
 #if WITH_EDITOR
 	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
 #endif // WITH_EDITOR
-};
\ No newline at end of file
+};
+////////////////////////////////////////////////////////////////////
+
+/**
+ *  Instance data struct for the Follow Flow Field task
+ */
+USTRUCT()
+struct FStateTreeFollowFlowFieldInstanceData
+{
+	GENERATED_BODY()
+
+	/** Character that will move */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<ACharacter> Character;
+
+	/** AI Controller used for the pathfinding fallback */
+	UPROPERTY(EditAnywhere, Category = Context)
+	TObjectPtr<AAIController> Controller;
+
+	/** Actor to chase. Flow fields always lead to the player */
+	UPROPERTY(EditAnywhere, Category = Input)
+	TObjectPtr<AActor> Target;
+
+	/** Distance to the target at which the task succeeds */
+	UPROPERTY(EditAnywhere, Category = Parameter, meta = (ClampMin = 0, Units = "cm"))
+	float AcceptanceRadius = 150.0f;
+
+	/** True while moving with the pathfinding fallback */
+	bool bUsingPathfinding = false;
+};
+
+/**
+ *  StateTree task to chase the target along the arena's flow field.
+ *  Falls back to regular pathfinding outside of flow field arenas.
+ */
+USTRUCT(meta=(DisplayName="Follow Flow Field", Category="Combat"))
+struct FStateTreeFollowFlowFieldTask : public FStateTreeTaskCommonBase
+{
+	GENERATED_BODY()
+
+	/* Ensure we're using the correct instance data struct */
+	using FInstanceDataType = FStateTreeFollowFlowFieldInstanceData;
+	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
+
+	/** Runs while the owning state is active */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+
+	/** Runs when the owning state is ended */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+
+#if WITH_EDITOR
+	virtual FText GetDescription(const FGuid& ID, FStateTreeDataView InstanceDataView, const IStateTreeBindingLookup& BindingLookup, EStateTreeNodeFormatting Formatting = EStateTreeNodeFormatting::Text) const override;
+#endif // WITH_EDITOR
+};
@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "CombatWaveDirectorSettings.generated.h"
+
+/**
+ *  Project settings for the combat wave director.
+ *  Controls how many enemies may be alive at once and how spawn work is spread across frames.
+ */
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Combat Wave Director"))
+class UCombatWaveDirectorSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Max number of spawned enemies alive at once. Spawns wait until enemies die */
+	UPROPERTY(Config, EditAnywhere, Category="Caps", meta = (ClampMin = 1, ClampMax = 200))
+	int32 MaxLiveEnemies = 16;
+
+	/** Total spawn cost allowed each frame. Each spawner's SpawnCost is counted against it */
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta = (ClampMin = 0.1, ClampMax = 20))
+	float SpawnBudgetPerFrame = 1.0f;
+
+	/** Min time between two frames with spawns, so simultaneous activations are staggered */
+	UPROPERTY(Config, EditAnywhere, Category="Budget", meta = (ClampMin = 0, ClampMax = 2, Units = "s"))
+	float MinSpawnInterval = 0.1f;
+
+	/** Number of frames kept in the spawn timeline */
+	UPROPERTY(Config, EditAnywhere, Category="Timeline", meta = (ClampMin = 60, ClampMax = 36000))
+	int32 TimelineFrames = 3600;
+};
@@ -0,0 +1,217 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatWaveDirectorSubsystem.h"
+#include "CombatWaveDirectorSettings.h"
+#include "CombatEnemySpawner.h"
+#include "CombatEnemy.h"
+#include "MyProject.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Engine/World.h"
+
+CSV_DEFINE_CATEGORY(CombatWaves, true);
+
+namespace CombatWaveDirector
+{
+	/** Writes the spawn timeline for the world to a CSV file */
+	static FAutoConsoleCommandWithWorldAndArgs DumpTimelineCommand(
+		TEXT("MyProject.Waves.DumpTimeline"),
+		TEXT("Writes the recent per-frame timeline of enemy spawns against frame time to a CSV file. Usage: MyProject.Waves.DumpTimeline [Filename]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UCombatWaveDirectorSubsystem* Director = World ? World->GetSubsystem<UCombatWaveDirectorSubsystem>() : nullptr;
+
+			if (!Director)
+			{
+				return;
+			}
+
+			const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::Combine(FPaths::ProfilingDir(), TEXT("WaveTimeline.csv"));
+
+			if (Director->DumpTimeline(Filename))
+			{
+				UE_LOG(LogMyProject, Display, TEXT("Wrote wave timeline to %s"), *Filename);
+
+			} else {
+
+				UE_LOG(LogMyProject, Warning, TEXT("Couldn't write wave timeline to %s"), *Filename);
+			}
+		}));
+}
+
+void UCombatWaveDirectorSubsystem::RegisterSpawner(ACombatEnemySpawner* Spawner)
+{
+	if (Spawner)
+	{
+		Spawners.AddUnique(Spawner);
+	}
+}
+
+void UCombatWaveDirectorSubsystem::UnregisterSpawner(ACombatEnemySpawner* Spawner)
+{
+	Spawners.Remove(Spawner);
+	Requests.RemoveAll([Spawner](const FSpawnRequest& Request) { return Request.Spawner.Get() == Spawner; });
+}
+
+void UCombatWaveDirectorSubsystem::RequestSpawn(ACombatEnemySpawner* Spawner)
+{
+	if (!Spawner)
+	{
+		return;
+	}
+
+	FSpawnRequest& Request = Requests.AddDefaulted_GetRef();
+	Request.Spawner = Spawner;
+	Request.RequestTime = GetWorld()->GetTimeSeconds();
+}
+
+void UCombatWaveDirectorSubsystem::NotifyEnemyDied(ACombatEnemySpawner* Spawner)
+{
+	const int32 Index = LiveEnemies.IndexOfByPredicate([Spawner](const FLiveEnemy& Live) { return Live.Spawner.Get() == Spawner; });
+
+	if (Index != INDEX_NONE)
+	{
+		LiveEnemies.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+}
+
+void UCombatWaveDirectorSubsystem::ResetSpawner(ACombatEnemySpawner* Spawner, ACombatEnemy* LiveEnemy)
+{
+	Requests.RemoveAll([Spawner](const FSpawnRequest& Request) { return Request.Spawner.Get() == Spawner; });
+	LiveEnemies.RemoveAllSwap([Spawner](const FLiveEnemy& Live) { return Live.Spawner.Get() == Spawner; });
+
+	if (LiveEnemy)
+	{
+		FLiveEnemy& Live = LiveEnemies.AddDefaulted_GetRef();
+		Live.Enemy = LiveEnemy;
+		Live.Spawner = Spawner;
+	}
+}
+
+bool UCombatWaveDirectorSubsystem::DumpTimeline(const FString& Filename) const
+{
+	FString Csv = TEXT("Frame,Time,FrameMs,Spawns,SpawnMs,SpawnCost,LiveEnemies,QueuedSpawns,MaxWaitSeconds\n");
+
+	// walk the ring buffer from the oldest frame
+	for (int32 i = 0; i < Timeline.Num(); ++i)
+	{
+		const FTimelineFrame& Frame = Timeline[(TimelineHead + i) % Timeline.Num()];
+
+		Csv += FString::Printf(TEXT("%llu,%.3f,%.3f,%d,%.3f,%.2f,%d,%d,%.3f\n"), Frame.Frame, Frame.Time, Frame.FrameMs, Frame.NumSpawns, Frame.SpawnMs, Frame.SpawnCost, Frame.NumLive, Frame.NumQueued, Frame.MaxWaitSeconds);
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *Filename);
+}
+
+void UCombatWaveDirectorSubsystem::ProcessRequests(FTimelineFrame& Frame)
+{
+	const UCombatWaveDirectorSettings* Settings = GetDefault<UCombatWaveDirectorSettings>();
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// stagger spawn frames so spawners activated together don't all land at once
+	if (Requests.IsEmpty() || Now - LastSpawnTime < Settings->MinSpawnInterval)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NumServed = 0;
+
+	while (NumServed < Requests.Num() && LiveEnemies.Num() < Settings->MaxLiveEnemies)
+	{
+		const FSpawnRequest& Request = Requests[NumServed];
+		ACombatEnemySpawner* Spawner = Request.Spawner.Get();
+
+		// skip requests from spawners that went away
+		if (!Spawner)
+		{
+			++NumServed;
+			continue;
+		}
+
+		// always allow one spawn per frame, even if it's over budget on its own
+		const float Cost = Spawner->GetSpawnCost();
+
+		if (Frame.NumSpawns > 0 && Frame.SpawnCost + Cost > Settings->SpawnBudgetPerFrame)
+		{
+			break;
+		}
+
+		Frame.MaxWaitSeconds = FMath::Max(Frame.MaxWaitSeconds, static_cast<float>(Now - Request.RequestTime));
+		++NumServed;
+
+		if (ACombatEnemy* Enemy = Spawner->SpawnQueuedEnemy())
+		{
+			FLiveEnemy& Live = LiveEnemies.AddDefaulted_GetRef();
+			Live.Enemy = Enemy;
+			Live.Spawner = Spawner;
+
+			Frame.SpawnCost += Cost;
+			++Frame.NumSpawns;
+		}
+	}
+
+	Requests.RemoveAt(0, NumServed, EAllowShrinking::No);
+
+	if (Frame.NumSpawns > 0)
+	{
+		LastSpawnTime = Now;
+		Frame.SpawnMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+}
+
+void UCombatWaveDirectorSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// drop enemies that were destroyed without dying, so they don't hold on to live slots
+	LiveEnemies.RemoveAllSwap([](const FLiveEnemy& Live) { return !Live.Enemy.IsValid(); });
+
+	FTimelineFrame Frame;
+	Frame.Frame = GFrameCounter;
+	Frame.Time = GetWorld()->GetTimeSeconds();
+	Frame.FrameMs = static_cast<float>(FApp::GetDeltaTime() * 1000.0);
+
+	ProcessRequests(Frame);
+
+	Frame.NumLive = LiveEnemies.Num();
+	Frame.NumQueued = Requests.Num();
+
+	// record the frame into the timeline ring buffer
+	const int32 TimelineFrames = GetDefault<UCombatWaveDirectorSettings>()->TimelineFrames;
+
+	if (Timeline.Num() < TimelineFrames)
+	{
+		Timeline.Add(Frame);
+		TimelineHead = 0;
+
+	} else {
+
+		Timeline[TimelineHead] = Frame;
+		TimelineHead = (TimelineHead + 1) % Timeline.Num();
+	}
+
+	CSV_CUSTOM_STAT(CombatWaves, Spawns, Frame.NumSpawns, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(CombatWaves, SpawnMs, Frame.SpawnMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(CombatWaves, LiveEnemies, Frame.NumLive, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(CombatWaves, QueuedSpawns, Frame.NumQueued, ECsvCustomStatOp::Set);
+}
+
+TStatId UCombatWaveDirectorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatWaveDirectorSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatWaveDirectorSubsystem::Deinitialize()
+{
+	Spawners.Empty();
+	Requests.Empty();
+	LiveEnemies.Empty();
+	Timeline.Empty();
+
+	Super::Deinitialize();
+}
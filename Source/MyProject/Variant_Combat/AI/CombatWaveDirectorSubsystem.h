@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatWaveDirectorSubsystem.generated.h"
+
+class ACombatEnemySpawner;
+class ACombatEnemy;
+
+/**
+ *  Owns all enemy spawners in the world and decides when their spawns actually happen.
+ *  Spawners queue spawn requests instead of spawning directly. Requests are served in order,
+ *  against a per-frame spawn cost budget and a min interval between spawn frames,
+ *  and are held back while the global live enemy cap is reached.
+ *  A per-frame timeline of spawns against frame time can be exported with MyProject.Waves.DumpTimeline.
+ */
+UCLASS()
+class UCombatWaveDirectorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** A queued spawn */
+	struct FSpawnRequest
+	{
+		/** Spawner to spawn from */
+		TWeakObjectPtr<ACombatEnemySpawner> Spawner;
+
+		/** World time the spawn was requested */
+		double RequestTime = 0.0;
+	};
+
+	/** A spawned enemy still alive */
+	struct FLiveEnemy
+	{
+		/** Enemy actor */
+		TWeakObjectPtr<ACombatEnemy> Enemy;
+
+		/** Spawner that spawned it */
+		TWeakObjectPtr<ACombatEnemySpawner> Spawner;
+	};
+
+	/** A single frame of the spawn timeline */
+	struct FTimelineFrame
+	{
+		/** Frame counter and world time */
+		uint64 Frame = 0;
+		double Time = 0.0;
+
+		/** Game thread frame time */
+		float FrameMs = 0.0f;
+
+		/** Spawns this frame and the time they took */
+		int32 NumSpawns = 0;
+		float SpawnMs = 0.0f;
+
+		/** Spawn cost used this frame */
+		float SpawnCost = 0.0f;
+
+		/** Live enemies and queued requests at the end of the frame */
+		int32 NumLive = 0;
+		int32 NumQueued = 0;
+
+		/** Longest time a request served this frame spent in the queue */
+		float MaxWaitSeconds = 0.0f;
+	};
+
+	/** Registered spawners */
+	TArray<TWeakObjectPtr<ACombatEnemySpawner>> Spawners;
+
+	/** Pending spawn requests, in request order */
+	TArray<FSpawnRequest> Requests;
+
+	/** Enemies spawned through the director that haven't died */
+	TArray<FLiveEnemy> LiveEnemies;
+
+	/** Ring buffer of recent frames */
+	TArray<FTimelineFrame> Timeline;
+
+	/** Next timeline entry to write */
+	int32 TimelineHead = 0;
+
+	/** World time of the last frame with spawns */
+	double LastSpawnTime = -1000.0;
+
+public:
+
+	/** Registers a spawner with the director */
+	void RegisterSpawner(ACombatEnemySpawner* Spawner);
+
+	/** Unregisters a spawner and drops its pending requests */
+	void UnregisterSpawner(ACombatEnemySpawner* Spawner);
+
+	/** Queues a spawn for the spawner */
+	void RequestSpawn(ACombatEnemySpawner* Spawner);
+
+	/** Tells the director an enemy from the spawner has died, freeing up its slot under the live cap */
+	void NotifyEnemyDied(ACombatEnemySpawner* Spawner);
+
+	/** Drops the spawner's queued spawns and live enemies, then tracks the provided live enemy, if any. Used when restoring checkpoints */
+	void ResetSpawner(ACombatEnemySpawner* Spawner, ACombatEnemy* LiveEnemy);
+
+	/** Returns the number of live spawned enemies */
+	int32 GetNumLiveEnemies() const { return LiveEnemies.Num(); }
+
+	/** Returns the number of queued spawn requests */
+	int32 GetNumQueuedSpawns() const { return Requests.Num(); }
+
+	/** Writes the spawn timeline to a CSV file. Returns false if the file couldn't be written */
+	bool DumpTimeline(const FString& Filename) const;
+
+protected:
+
+	/** Serves queued requests within this frame's budget. Fills in the spawn fields of the timeline frame */
+	void ProcessRequests(FTimelineFrame& Frame);
+
+public:
+
+	/** Spawns queued enemies */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+};
@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "AnimNotifyState_AttackWindow.h"
+#include "CombatHitboxSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+
+void UAnimNotifyState_AttackWindow::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	// editor preview worlds don't have the hitbox subsystem
+	if (UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr)
+	{
+		if (UCombatHitboxSubsystem* Hitboxes = World->GetSubsystem<UCombatHitboxSubsystem>())
+		{
+			Hitboxes->BeginHitbox(MeshComp, SocketName, Radius, HalfHeight);
+		}
+	}
+}
+
+void UAnimNotifyState_AttackWindow::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+
+	if (UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr)
+	{
+		if (UCombatHitboxSubsystem* Hitboxes = World->GetSubsystem<UCombatHitboxSubsystem>())
+		{
+			Hitboxes->EndHitbox(MeshComp, SocketName);
+		}
+	}
+}
+
+FString UAnimNotifyState_AttackWindow::GetNotifyName_Implementation() const
+{
+	return FString("Attack Window");
+}
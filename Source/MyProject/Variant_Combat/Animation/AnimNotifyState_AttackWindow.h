@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "AnimNotifyState_AttackWindow.generated.h"
+
+/**
+ *  AnimNotifyState that opens a swept hitbox on a mesh socket for the duration of the notify.
+ *  Any targets the hitbox passes through are reported once to the owner's attacker interface.
+ *  Several windows on different sockets of the same montage share their hit targets.
+ */
+UCLASS()
+class UAnimNotifyState_AttackWindow : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+protected:
+
+	/** Socket or bone the hitbox follows */
+	UPROPERTY(EditAnywhere, Category="Attack")
+	FName SocketName;
+
+	/** Radius of the hitbox */
+	UPROPERTY(EditAnywhere, Category="Attack", meta = (ClampMin = 0, ClampMax = 200, Units = "cm"))
+	float Radius = 35.0f;
+
+	/** Half height of the hitbox along the socket's Z axis. A capsule is used if above the radius, a sphere otherwise */
+	UPROPERTY(EditAnywhere, Category="Attack", meta = (ClampMin = 0, ClampMax = 200, Units = "cm"))
+	float HalfHeight = 0.0f;
+
+public:
+
+	/** Opens the hitbox */
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
+
+	/** Closes the hitbox */
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+
+	/** Get the notify name */
+	virtual FString GetNotifyName_Implementation() const override;
+};
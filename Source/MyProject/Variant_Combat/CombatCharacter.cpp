@@ -2,6 +2,12 @@
 
 
 #include "CombatCharacter.h"
+#include "CharacterMovementProfile.h"
+#include "InputBufferComponent.h"
+#include "CombatHitStopSubsystem.h"
+#include "CombatTeams.h"
+#include "MyProjectCollisionChannels.h"
+#include "TraceBufferSubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/WidgetComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -12,10 +18,12 @@
 #include "EnhancedInputComponent.h"
 #include "CombatLifeBar.h"
 #include "Engine/DamageEvents.h"
-#include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
 #include "CombatPlayerController.h"
 
+/** Input buffer action shared by combo and charged attacks */
+static const FName AttackInputName(TEXT("Attack"));
+
 ACombatCharacter::ACombatCharacter()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -27,7 +35,10 @@ ACombatCharacter::ACombatCharacter()
 	GetCapsuleComponent()->InitCapsuleSize(35.0f, 90.0f);
 
 	// Configure character movement
-	GetCharacterMovement()->MaxWalkSpeed = 400.0f;
+	FCharacterMovementProfile DefaultMovementProfile;
+	DefaultMovementProfile.MaxWalkSpeed = 400.0f;
+
+	DefaultMovementProfile.ApplyTo(GetCharacterMovement());
 
 	// create the camera boom
 	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
@@ -47,8 +58,11 @@ ACombatCharacter::ACombatCharacter()
 	LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
 	LifeBar->SetupAttachment(RootComponent);
 
-	// set the player tag
-	Tags.Add(FName("Player"));
+	// create the input buffer
+	InputBuffer = CreateDefaultSubobject<UInputBufferComponent>(TEXT("InputBuffer"));
+
+	// join the player team
+	TeamId = CombatTeams::Player;
 }
 
 void ACombatCharacter::Move(const FInputActionValue& Value)
@@ -127,13 +141,13 @@ void ACombatCharacter::DoComboAttackStart()
 	// are we already playing an attack animation?
 	if (bIsAttacking)
 	{
-		// cache the input time so we can check it later
-		CachedAttackInputTime = GetWorld()->GetTimeSeconds();
-
+		// buffer the input so we can check it later
+		InputBuffer->BufferInput(AttackInputName);
 		return;
 	}
 
-	// perform a combo attack
+	// perform a combo attack right away. Only deferred inputs go through the buffer, so its latency stats stay meaningful
+	InputBuffer->ClearInput(AttackInputName);
 	ComboAttack();
 }
 
@@ -149,12 +163,13 @@ void ACombatCharacter::DoChargedAttackStart()
 
 	if (bIsAttacking)
 	{
-		// cache the input time so we can check it later
-		CachedAttackInputTime = GetWorld()->GetTimeSeconds();
-
+		// buffer the input so we can check it later
+		InputBuffer->BufferInput(AttackInputName);
 		return;
 	}
 
+	// perform a charged attack right away
+	InputBuffer->ClearInput(AttackInputName);
 	ChargedAttack();
 }
 
@@ -235,8 +250,8 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 	// reset the attacking flag
 	bIsAttacking = false;
 
-	// check if we have a non-stale cached input
-	if (GetWorld()->GetTimeSeconds() - CachedAttackInputTime <= AttackInputCacheTimeTolerance)
+	// check if we have a non-stale buffered input
+	if (InputBuffer->ConsumeInput(AttackInputName, AttackInputCacheTimeTolerance))
 	{
 		// are we holding the charged attack button?
 		if (bIsChargingAttack)
@@ -254,17 +269,16 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage* Montage, bool bInterrupt
 
 void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	// sweep for objects in front of the character to be hit by the attack.
+	// The hit buffer is borrowed from the world pool, so the sweep doesn't allocate
+	FScopedHitBuffer OutHits(GetWorld());
 
 	// start at the provided socket location, sweep forward
 	const FVector TraceStart = GetMesh()->GetSocketLocation(DamageSourceBone);
 	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * MeleeTraceDistance);
 
-	// check for pawn and world dynamic collision object types
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	// check for enemies and damageable props only. Other player pawns are never hit
+	const FCollisionObjectQueryParams ObjectParams = GetAttackObjectTypes();
 
 	// use a sphere shape for the sweep
 	FCollisionShape CollisionShape;
@@ -274,27 +288,45 @@ void ACombatCharacter::DoAttackTrace(FName DamageSourceBone)
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(this);
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	if (GetWorld()->SweepMultiByObjectType(*OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
 	{
 		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		for (const FHitResult& CurrentHit : *OutHits)
 		{
-			// check if we've hit a damageable actor
-			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
+			ApplyAttackHit(CurrentHit);
+		}
+	}
+}
 
-			if (Damageable)
-			{
-				// knock upwards and away from the impact normal
-				const FVector Impulse = (CurrentHit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+FCollisionObjectQueryParams ACombatCharacter::GetAttackObjectTypes() const
+{
+	return MyProjectCollision::PlayerAttackObjects();
+}
 
-				// pass the damage event to the actor
-				Damageable->ApplyDamage(MeleeDamage, this, CurrentHit.ImpactPoint, Impulse);
+void ACombatCharacter::ApplyAttackHit(const FHitResult& Hit)
+{
+	// check if we've hit a damageable actor
+	ICombatDamageable* Damageable = Cast<ICombatDamageable>(Hit.GetActor());
 
-				// call the BP handler to play effects, etc.
-				DealtDamage(MeleeDamage, CurrentHit.ImpactPoint);
-			}
-		}
+	if (!Damageable)
+	{
+		return;
+	}
+
+	// knock upwards and away from the impact normal
+	const FVector Impulse = (Hit.ImpactNormal * -MeleeKnockbackImpulse) + (FVector::UpVector * MeleeLaunchImpulse);
+
+	// pass the damage event to the actor
+	Damageable->ApplyDamage(MeleeDamage, this, Hit.ImpactPoint, Impulse);
+
+	// freeze both of us for a few frames to sell the impact
+	if (UCombatHitStopSubsystem* HitStop = GetWorld()->GetSubsystem<UCombatHitStopSubsystem>())
+	{
+		HitStop->ApplyHitStop(this, Hit.GetActor(), HitStopFrames, HitStopTimeDilation);
 	}
+
+	// call the BP handler to play effects, etc.
+	DealtDamage(MeleeDamage, Hit.ImpactPoint);
 }
 
 void ACombatCharacter::CheckCombo()
@@ -302,12 +334,9 @@ void ACombatCharacter::CheckCombo()
 	// are we playing a non-charge attack animation?
 	if (bIsAttacking && !bIsChargingAttack)
 	{
-		// is the last attack input not stale?
-		if (GetWorld()->GetTimeSeconds() - CachedAttackInputTime <= ComboInputCacheTimeTolerance)
+		// is the last attack input not stale? consume it so we don't accidentally trigger it twice
+		if (InputBuffer->ConsumeInput(AttackInputName, ComboInputCacheTimeTolerance))
 		{
-			// consume the attack input so we don't accidentally trigger it twice
-			CachedAttackInputTime = 0.0f;
-
 			// increase the combo counter
 			++ComboCount;
 
@@ -341,16 +370,16 @@ void ACombatCharacter::CheckChargedAttack()
 
 void ACombatCharacter::NotifyEnemiesOfIncomingAttack()
 {
-	// sweep for objects in front of the character to be hit by the attack
-	TArray<FHitResult> OutHits;
+	// sweep for objects in front of the character to be hit by the attack.
+	// The hit buffer is borrowed from the world pool, so the sweep doesn't allocate
+	FScopedHitBuffer OutHits(GetWorld());
 
 	// start at the actor location, sweep forward
 	const FVector TraceStart = GetActorLocation();
 	const FVector TraceEnd = TraceStart + (GetActorForwardVector() * DangerTraceDistance);
 
-	// check for pawn object types only
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	// check for enemies only
+	const FCollisionObjectQueryParams ObjectParams = MyProjectCollision::IncomingAttackObjects();
 
 	// use a sphere shape for the sweep
 	FCollisionShape CollisionShape;
@@ -360,10 +389,10 @@ void ACombatCharacter::NotifyEnemiesOfIncomingAttack()
 	FCollisionQueryParams QueryParams;
 	QueryParams.AddIgnoredActor(this);
 
-	if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
+	if (GetWorld()->SweepMultiByObjectType(*OutHits, TraceStart, TraceEnd, FQuat::Identity, ObjectParams, CollisionShape, QueryParams))
 	{
 		// iterate over each object hit
-		for (const FHitResult& CurrentHit : OutHits)
+		for (const FHitResult& CurrentHit : *OutHits)
 		{
 			// check if we've hit a damageable actor
 			ICombatDamageable* Damageable = Cast<ICombatDamageable>(CurrentHit.GetActor());
@@ -417,7 +446,10 @@ void ACombatCharacter::HandleDeath()
 	GetCameraBoom()->TargetArmLength = DeathCameraDistance;
 
 	// schedule respawning
-	GetWorld()->GetTimerManager().SetTimer(RespawnTimer, this, &ACombatCharacter::RespawnCharacter, RespawnTime, false);
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Reschedule(RespawnTimer, this, RespawnTime, &ACombatCharacter::RespawnCharacter);
+	}
 }
 
 void ACombatCharacter::ApplyHealing(float Healing, AActor* Healer)
@@ -432,10 +464,60 @@ void ACombatCharacter::NotifyDanger(const FVector& DangerLocation, AActor* Dange
 
 void ACombatCharacter::RespawnCharacter()
 {
-	// destroy the character and let it be respawned by the Player Controller
+	// let the Player Controller reset us in place
+	if (ACombatPlayerController* PC = Cast<ACombatPlayerController>(GetController()))
+	{
+		PC->RespawnCharacter(this);
+		return;
+	}
+
+	// destroy the character and let it be respawned by whoever owns it
 	Destroy();
 }
 
+void ACombatCharacter::ResetForRespawn(const FTransform& RespawnTransform)
+{
+	// cancel any pending respawn
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Cancel(RespawnTimer);
+	}
+
+	// drop any attack state from before we died
+	InputBuffer->ClearInput(AttackInputName);
+
+	bIsChargingAttack = false;
+	bHasLoopedChargedAttack = false;
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->Montage_Stop(0.0f);
+	}
+
+	bIsAttacking = false;
+	ComboCount = 0;
+
+	// undo the ragdoll and snap the mesh back onto the capsule
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	GetMesh()->SetRelativeTransform(MeshStartingTransform);
+
+	// move to the respawn point and restore movement
+	SetActorTransform(RespawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	// reset the camera
+	GetCameraBoom()->TargetArmLength = DefaultCameraDistance;
+
+	// show the life bar and refill HP
+	LifeBar->SetHiddenInGame(false);
+
+	ResetHP();
+}
+
 float ACombatCharacter::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	// only process damage if the character is still alive
@@ -483,6 +565,12 @@ void ACombatCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// apply the movement profile override, if any
+	if (MovementProfile)
+	{
+		MovementProfile->Profile.ApplyTo(GetCharacterMovement());
+	}
+
 	// get the life bar from the widget component
 	LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
 	check(LifeBarWidget);
@@ -504,8 +592,16 @@ void ACombatCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the respawn timer
-	GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+	// cancel the respawn timer
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->CancelAll(this);
+	}
+}
+
+FGenericTeamId ACombatCharacter::GetGenericTeamId() const
+{
+	return TeamId;
 }
 
 void ACombatCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
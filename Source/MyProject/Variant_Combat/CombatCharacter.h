@@ -6,7 +6,9 @@
 #include "GameFramework/Character.h"
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
+#include "GenericTeamAgentInterface.h"
 #include "Animation/AnimInstance.h"
+#include "GameplaySchedulerSubsystem.h"
 #include "CombatCharacter.generated.h"
 
 class USpringArmComponent;
@@ -15,6 +17,8 @@ class UInputAction;
 struct FInputActionValue;
 class UCombatLifeBar;
 class UWidgetComponent;
+class UInputBufferComponent;
+class UCharacterMovementProfileAsset;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
 
@@ -27,7 +31,7 @@ DECLARE_LOG_CATEGORY_EXTERN(LogCombatCharacter, Log, All);
  *  - Respawning
  */
 UCLASS(abstract)
-class ACombatCharacter : public ACharacter, public ICombatAttacker, public ICombatDamageable
+class ACombatCharacter : public ACharacter, public ICombatAttacker, public ICombatDamageable, public IGenericTeamAgentInterface
 {
 	GENERATED_BODY()
 
@@ -42,6 +46,10 @@ class ACombatCharacter : public ACharacter, public ICombatAttacker, public IComb
 	/** Life bar widget component */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UWidgetComponent* LifeBar;
+
+	/** Buffers attack inputs received while we're busy attacking */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UInputBufferComponent* InputBuffer;
 	
 protected:
 
@@ -97,9 +105,6 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
 	float AttackInputCacheTimeTolerance = 1.0f;
 
-	/** Time at which an attack button was last pressed */
-	float CachedAttackInputTime = 0.0f;
-
 	/** If true, the character is currently playing an attack animation */
 	bool bIsAttacking = false;
 
@@ -131,6 +136,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Damage", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm/s"))
 	float MeleeLaunchImpulse = 300.0f;
 
+	/** Number of frames the attacker and victim freeze for when a melee attack connects. 0 disables hit-stop */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Hit Stop", meta = (ClampMin = 0, ClampMax = 30))
+	int32 HitStopFrames = 4;
+
+	/** Time dilation applied to the attacker and victim during hit-stop */
+	UPROPERTY(EditAnywhere, Category="Melee Attack|Hit Stop", meta = (ClampMin = 0, ClampMax = 1))
+	float HitStopTimeDilation = 0.01f;
+
 	/** AnimMontage that will play for combo attacks */
 	UPROPERTY(EditAnywhere, Category="Melee Attack|Combo")
 	UAnimMontage* ComboAttackMontage;
@@ -164,6 +177,10 @@ protected:
 	/** If true, the charged attack hold check has been tested at least once */
 	bool bHasLoopedChargedAttack = false;
 
+	/** Optional movement profile override. If unset, the character movement component values are used */
+	UPROPERTY(EditAnywhere, Category="Movement Profile")
+	UCharacterMovementProfileAsset* MovementProfile;
+
 	/** Camera boom length while the character is dead */
 	UPROPERTY(EditAnywhere, Category="Camera", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
 	float DeathCameraDistance = 400.0f;
@@ -172,6 +189,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Camera", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
 	float DefaultCameraDistance = 100.0f;
 
+	/** Team this character belongs to. Characters on other teams are treated as hostile */
+	UPROPERTY(EditAnywhere, Category="Team")
+	FGenericTeamId TeamId;
+
 	/** Time to wait before respawning the character */
 	UPROPERTY(EditAnywhere, Category="Respawn", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float RespawnTime = 3.0f;
@@ -180,7 +201,7 @@ protected:
 	FOnMontageEnded OnAttackMontageEnded;
 
 	/** Character respawn timer */
-	FTimerHandle RespawnTimer;
+	FGameplayScheduleHandle RespawnTimer;
 
 	/** Copy of the mesh's transform so we can reset it after ragdoll animations */
 	FTransform MeshStartingTransform;
@@ -268,6 +289,12 @@ public:
 	/** Performs the charged attack hold check */
 	virtual void CheckChargedAttack() override;
 
+	/** Returns the collision object types our hitboxes can hit */
+	virtual FCollisionObjectQueryParams GetAttackObjectTypes() const override;
+
+	/** Applies damage, knockback and hit-stop to a target hit by an attack */
+	virtual void ApplyAttackHit(const FHitResult& Hit) override;
+
 	// ~end CombatAttacker interface
 
 	// ~begin CombatDamageable interface
@@ -289,11 +316,21 @@ public:
 
 	// ~end CombatDamageable interface
 
-	/** Called from the respawn timer to destroy and re-create the character */
+	// ~begin IGenericTeamAgentInterface
+
+	/** Returns the team this character belongs to */
+	virtual FGenericTeamId GetGenericTeamId() const override;
+
+	// ~end IGenericTeamAgentInterface
+
+	/** Called from the respawn timer. Lets the Player Controller reset us in place, or destroys the character to have it re-created */
 	void RespawnCharacter();
 
 public:
 
+	/** Resets the character in place at the given transform after dying: HP, ragdoll, mesh, camera and life bar */
+	void ResetForRespawn(const FTransform& RespawnTransform);
+
 	/** Overrides the default TakeDamage functionality */
 	virtual float TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
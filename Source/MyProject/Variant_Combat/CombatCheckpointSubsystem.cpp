@@ -0,0 +1,211 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatCheckpointSubsystem.h"
+#include "CombatCheckpointable.h"
+#include "MyProject.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+CSV_DEFINE_CATEGORY(CombatCheckpoint, true);
+
+namespace CombatCheckpoint
+{
+	static TAutoConsoleVariable<float> CVarRestoreBudgetMs(
+		TEXT("MyProject.Checkpoint.RestoreBudgetMs"),
+		16.6f,
+		TEXT("Target time for restoring a checkpoint snapshot, in milliseconds. Restores over this are logged as warnings"),
+		ECVF_Default);
+
+	/** Captures a checkpoint snapshot of the world */
+	static FAutoConsoleCommandWithWorld CaptureCommand(
+		TEXT("MyProject.Checkpoint.Capture"),
+		TEXT("Captures a checkpoint snapshot of the combat world state"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UCombatCheckpointSubsystem* Checkpoints = World ? World->GetSubsystem<UCombatCheckpointSubsystem>() : nullptr)
+			{
+				Checkpoints->CaptureSnapshot();
+			}
+		}));
+
+	/** Restores the world from the last checkpoint snapshot */
+	static FAutoConsoleCommandWithWorld RestoreCommand(
+		TEXT("MyProject.Checkpoint.Restore"),
+		TEXT("Restores the combat world state from the last checkpoint snapshot and logs the time taken"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UCombatCheckpointSubsystem* Checkpoints = World ? World->GetSubsystem<UCombatCheckpointSubsystem>() : nullptr)
+			{
+				Checkpoints->RestoreSnapshot();
+			}
+		}));
+}
+
+void UCombatCheckpointSubsystem::RegisterActor(AActor* Actor)
+{
+	if (Actor && ensure(Cast<ICombatCheckpointable>(Actor)))
+	{
+		Checkpointables.Add(Actor->GetFName(), Actor);
+	}
+}
+
+void UCombatCheckpointSubsystem::UnregisterActor(AActor* Actor)
+{
+	if (Actor)
+	{
+		Checkpointables.Remove(Actor->GetFName());
+	}
+}
+
+void UCombatCheckpointSubsystem::CaptureSnapshot()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Snapshot.Reset();
+	FMemoryWriter Writer(Snapshot);
+
+	uint32 Version = SnapshotVersion;
+	int32 NumEntries = 0;
+
+	Writer << Version;
+
+	// reserve the entry count and patch it once we know how many live actors we wrote
+	const int64 CountOffset = Writer.Tell();
+	Writer << NumEntries;
+
+	for (const TPair<FName, TWeakObjectPtr<AActor>>& Pair : Checkpointables)
+	{
+		ICombatCheckpointable* Checkpointable = Cast<ICombatCheckpointable>(Pair.Value.Get());
+
+		if (!Checkpointable)
+		{
+			continue;
+		}
+
+		FName Key = Pair.Key;
+		Writer << Key;
+
+		// reserve the payload size so restores can skip entries for actors that no longer exist
+		const int64 SizeOffset = Writer.Tell();
+		int32 PayloadSize = 0;
+		Writer << PayloadSize;
+
+		Checkpointable->SaveCheckpointState(Writer);
+
+		const int64 EndOffset = Writer.Tell();
+		PayloadSize = static_cast<int32>(EndOffset - SizeOffset - sizeof(int32));
+
+		Writer.Seek(SizeOffset);
+		Writer << PayloadSize;
+		Writer.Seek(EndOffset);
+
+		++NumEntries;
+	}
+
+	const int64 EndOffset = Writer.Tell();
+	Writer.Seek(CountOffset);
+	Writer << NumEntries;
+	Writer.Seek(EndOffset);
+
+	UE_LOG(LogMyProject, Log, TEXT("Captured checkpoint: %d actors, %d bytes, %.3f ms"), NumEntries, Snapshot.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+bool UCombatCheckpointSubsystem::RestoreSnapshot()
+{
+	if (!HasSnapshot())
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FMemoryReader Reader(Snapshot);
+
+	uint32 Version = 0;
+	int32 NumEntries = 0;
+
+	Reader << Version;
+
+	if (Version != SnapshotVersion)
+	{
+		UE_LOG(LogMyProject, Warning, TEXT("Discarding checkpoint snapshot with version %u"), Version);
+		Snapshot.Reset();
+		return false;
+	}
+
+	Reader << NumEntries;
+
+	RestoredActors.Reset();
+
+	for (int32 i = 0; i < NumEntries && !Reader.IsError(); ++i)
+	{
+		FName Key;
+		int32 PayloadSize = 0;
+
+		Reader << Key;
+		Reader << PayloadSize;
+
+		const int64 PayloadEnd = Reader.Tell() + PayloadSize;
+
+		const TWeakObjectPtr<AActor>* Actor = Checkpointables.Find(Key);
+
+		if (ICombatCheckpointable* Checkpointable = Actor ? Cast<ICombatCheckpointable>(Actor->Get()) : nullptr)
+		{
+			Checkpointable->LoadCheckpointState(Reader);
+			RestoredActors.Add(Key);
+		}
+
+		// always continue from the end of the entry, even if the actor is gone or read less than it wrote
+		Reader.Seek(PayloadEnd);
+	}
+
+	// reset actors created since the snapshot, then let everyone fix up cross-actor state
+	for (const TPair<FName, TWeakObjectPtr<AActor>>& Pair : Checkpointables)
+	{
+		if (!RestoredActors.Contains(Pair.Key))
+		{
+			if (ICombatCheckpointable* Checkpointable = Cast<ICombatCheckpointable>(Pair.Value.Get()))
+			{
+				Checkpointable->RestoreMissingCheckpointState();
+			}
+		}
+	}
+
+	for (const TPair<FName, TWeakObjectPtr<AActor>>& Pair : Checkpointables)
+	{
+		if (ICombatCheckpointable* Checkpointable = Cast<ICombatCheckpointable>(Pair.Value.Get()))
+		{
+			Checkpointable->PostCheckpointRestored();
+		}
+	}
+
+	const float ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	const float BudgetMs = CombatCheckpoint::CVarRestoreBudgetMs.GetValueOnGameThread();
+
+	CSV_CUSTOM_STAT(CombatCheckpoint, RestoreMs, ElapsedMs, ECsvCustomStatOp::Set);
+
+	if (ElapsedMs > BudgetMs)
+	{
+		UE_LOG(LogMyProject, Warning, TEXT("Restored checkpoint: %d actors in %.3f ms, over the %.1f ms budget"), RestoredActors.Num(), ElapsedMs, BudgetMs);
+
+	} else {
+
+		UE_LOG(LogMyProject, Log, TEXT("Restored checkpoint: %d actors in %.3f ms"), RestoredActors.Num(), ElapsedMs);
+	}
+
+	return true;
+}
+
+void UCombatCheckpointSubsystem::Deinitialize()
+{
+	Checkpointables.Empty();
+	Snapshot.Empty();
+	RestoredActors.Empty();
+
+	Super::Deinitialize();
+}
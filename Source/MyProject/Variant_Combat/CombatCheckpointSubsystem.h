@@ -0,0 +1,51 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatCheckpointSubsystem.generated.h"
+
+/**
+ *  Captures and restores checkpoint snapshots of the combat world state.
+ *  Checkpointable actors register themselves, and a snapshot serializes each of them into a single compact binary blob.
+ *  Restoring applies the blob back to the same actors in place, without reloading the level or recreating actors.
+ *  Restore time is measured against MyProject.Checkpoint.RestoreBudgetMs.
+ */
+UCLASS()
+class UCombatCheckpointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Bumped whenever the snapshot layout changes */
+	static constexpr uint32 SnapshotVersion = 1;
+
+	/** Registered checkpointable actors, keyed by name */
+	TMap<FName, TWeakObjectPtr<AActor>> Checkpointables;
+
+	/** Serialized world state for the last checkpoint */
+	TArray<uint8> Snapshot;
+
+	/** Actors restored during the current restore. Kept around to avoid allocations */
+	TSet<FName> RestoredActors;
+
+public:
+
+	/** Registers an actor implementing ICombatCheckpointable */
+	void RegisterActor(AActor* Actor);
+
+	/** Unregisters the actor */
+	void UnregisterActor(AActor* Actor);
+
+	/** Serializes all registered actors into the checkpoint snapshot */
+	void CaptureSnapshot();
+
+	/** Restores all registered actors from the checkpoint snapshot. Returns false if there's no snapshot */
+	bool RestoreSnapshot();
+
+	/** Returns true if a snapshot has been captured */
+	bool HasSnapshot() const { return Snapshot.Num() > 0; }
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+};
@@ -0,0 +1,23 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "CombatHitStopSettings.generated.h"
+
+/**
+ *  Project settings for melee hit-stop.
+ *  Hit-stop durations are tuned per character, this only controls whether hit-stop is applied at all.
+ */
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Combat Hit Stop"))
+class UCombatHitStopSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/** If true, the attacker and victim of a melee hit freeze for their configured number of hit-stop frames */
+	UPROPERTY(Config, EditAnywhere, Category="Hit Stop")
+	bool bEnableHitStop = false;
+};
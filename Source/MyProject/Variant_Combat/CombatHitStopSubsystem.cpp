@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHitStopSubsystem.h"
+#include "CombatHitStopSettings.h"
+#include "GameFramework/Actor.h"
+
+void UCombatHitStopSubsystem::ApplyHitStop(AActor* Attacker, AActor* Victim, int32 Frames, float TimeDilation)
+{
+	ApplyHitStopToActor(Attacker, Frames, TimeDilation);
+	ApplyHitStopToActor(Victim, Frames, TimeDilation);
+}
+
+void UCombatHitStopSubsystem::ApplyHitStopToActor(AActor* Actor, int32 Frames, float TimeDilation)
+{
+	// hit-stop is opt-in through the project settings
+	if (!Actor || Frames <= 0 || !GetDefault<UCombatHitStopSettings>()->bEnableHitStop)
+	{
+		return;
+	}
+
+	FHitStopEntry* Entry = ActiveHitStops.FindByPredicate([Actor](const FHitStopEntry& Current) { return Current.Actor.Get() == Actor; });
+
+	if (Entry)
+	{
+		// already stopped, so extend the duration but keep the original dilation to restore
+		Entry->FramesLeft = FMath::Max(Entry->FramesLeft, Frames);
+
+	} else {
+
+		Entry = &ActiveHitStops.AddDefaulted_GetRef();
+		Entry->Actor = Actor;
+		Entry->RestoreTimeDilation = Actor->CustomTimeDilation;
+		Entry->FramesLeft = Frames;
+	}
+
+	Entry->StartFrame = GFrameCounter;
+
+	// dilate the actor. Its components, including the skeletal mesh and anim instance, tick with the dilated time
+	Actor->CustomTimeDilation = TimeDilation;
+}
+
+void UCombatHitStopSubsystem::ClearHitStop(AActor* Actor)
+{
+	for (int32 i = ActiveHitStops.Num() - 1; i >= 0; --i)
+	{
+		if (ActiveHitStops[i].Actor.Get() == Actor)
+		{
+			Actor->CustomTimeDilation = ActiveHitStops[i].RestoreTimeDilation;
+			ActiveHitStops.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+}
+
+void UCombatHitStopSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// count in frames rather than time so the duration is exact regardless of frame rate or dilation
+	for (int32 i = ActiveHitStops.Num() - 1; i >= 0; --i)
+	{
+		FHitStopEntry& Entry = ActiveHitStops[i];
+		AActor* Actor = Entry.Actor.Get();
+
+		// drop actors destroyed while stopped
+		if (!Actor)
+		{
+			ActiveHitStops.RemoveAtSwap(i, EAllowShrinking::No);
+			continue;
+		}
+
+		// the frame the hit landed on doesn't count
+		if (Entry.StartFrame == GFrameCounter)
+		{
+			continue;
+		}
+
+		if (--Entry.FramesLeft <= 0)
+		{
+			// restore the actor's time dilation
+			Actor->CustomTimeDilation = Entry.RestoreTimeDilation;
+			ActiveHitStops.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+}
+
+TStatId UCombatHitStopSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatHitStopSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatHitStopSubsystem::Deinitialize()
+{
+	// don't leave any actors frozen
+	for (const FHitStopEntry& Entry : ActiveHitStops)
+	{
+		if (AActor* Actor = Entry.Actor.Get())
+		{
+			Actor->CustomTimeDilation = Entry.RestoreTimeDilation;
+		}
+	}
+
+	ActiveHitStops.Empty();
+
+	Super::Deinitialize();
+}
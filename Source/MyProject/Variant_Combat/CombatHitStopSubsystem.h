@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatHitStopSubsystem.generated.h"
+
+/**
+ *  Freezes the attacker and victim of a melee hit for a fixed number of frames.
+ *  Uses per-actor custom time dilation instead of global time dilation, so the rest of the
+ *  world and the timer manager keep running at normal speed.
+ *  Skeletal meshes and their anim instances inherit the dilation from their owning actor.
+ *  Does nothing unless hit-stop is enabled in the Combat Hit Stop project settings.
+ */
+UCLASS()
+class UCombatHitStopSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** An actor currently in hit-stop */
+	struct FHitStopEntry
+	{
+		/** Actor being dilated */
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Custom time dilation to restore once the hit-stop ends */
+		float RestoreTimeDilation = 1.0f;
+
+		/** Number of frames left before the hit-stop ends */
+		int32 FramesLeft = 0;
+
+		/** Frame the hit-stop was last applied on. That frame doesn't count towards the duration */
+		uint64 StartFrame = 0;
+	};
+
+	/** Actors currently in hit-stop */
+	TArray<FHitStopEntry> ActiveHitStops;
+
+public:
+
+	/** Applies hit-stop to both the attacker and the victim of a hit */
+	UFUNCTION(BlueprintCallable, Category="Hit Stop")
+	void ApplyHitStop(AActor* Attacker, AActor* Victim, int32 Frames, float TimeDilation = 0.01f);
+
+	/** Applies hit-stop to a single actor. Extends the hit-stop if the actor is already stopped */
+	UFUNCTION(BlueprintCallable, Category="Hit Stop")
+	void ApplyHitStopToActor(AActor* Actor, int32 Frames, float TimeDilation = 0.01f);
+
+	/** Ends hit-stop on an actor early, restoring its time dilation */
+	UFUNCTION(BlueprintCallable, Category="Hit Stop")
+	void ClearHitStop(AActor* Actor);
+
+public:
+
+	/** Counts down the active hit-stops */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** Restores all affected actors */
+	virtual void Deinitialize() override;
+};
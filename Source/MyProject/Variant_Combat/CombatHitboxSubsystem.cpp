@@ -0,0 +1,194 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatHitboxSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+
+void UCombatHitboxSubsystem::BeginHitbox(USkeletalMeshComponent* Mesh, FName SocketName, float Radius, float HalfHeight)
+{
+	if (!Mesh)
+	{
+		return;
+	}
+
+	FAttackWindow* Window = FindOpenWindow(Mesh);
+
+	if (!Window)
+	{
+		// cast the owner to the attacker interface
+		ICombatAttacker* Attacker = Cast<ICombatAttacker>(Mesh->GetOwner());
+
+		// meshes without an attacker, such as editor previews, don't need hitboxes
+		if (!Attacker)
+		{
+			return;
+		}
+
+		Window = &AttackWindows.AddDefaulted_GetRef();
+		Window->Serial = NextSerial++;
+		Window->Mesh = Mesh;
+		Window->Attacker = Attacker;
+	}
+
+	// ignore duplicate hitboxes on the same socket
+	if (Window->Hitboxes.ContainsByPredicate([SocketName](const FHitbox& Hitbox) { return Hitbox.SocketName == SocketName; }))
+	{
+		return;
+	}
+
+	FHitbox& Hitbox = Window->Hitboxes.AddDefaulted_GetRef();
+	Hitbox.SocketName = SocketName;
+	Hitbox.Radius = Radius;
+	Hitbox.HalfHeight = HalfHeight;
+	Hitbox.LastLocation = Mesh->GetSocketLocation(SocketName);
+}
+
+void UCombatHitboxSubsystem::EndHitbox(USkeletalMeshComponent* Mesh, FName SocketName)
+{
+	FAttackWindow* Window = FindOpenWindow(Mesh);
+
+	if (!Window)
+	{
+		return;
+	}
+
+	const int32 HitboxIndex = Window->Hitboxes.IndexOfByPredicate([SocketName](const FHitbox& Hitbox) { return Hitbox.SocketName == SocketName; });
+
+	if (HitboxIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// cover the stretch the socket moved since the last sweep
+	SweepHitbox(*Window, Window->Hitboxes[HitboxIndex]);
+
+	Window->Hitboxes.RemoveAt(HitboxIndex);
+
+	// close the window once all hitboxes are done. It stays around until its sweeps complete
+	if (Window->Hitboxes.IsEmpty())
+	{
+		Window->bClosed = true;
+	}
+}
+
+UCombatHitboxSubsystem::FAttackWindow* UCombatHitboxSubsystem::FindOpenWindow(const USkeletalMeshComponent* Mesh)
+{
+	return AttackWindows.FindByPredicate([Mesh](const FAttackWindow& Window) { return !Window.bClosed && Window.Mesh.Get() == Mesh; });
+}
+
+void UCombatHitboxSubsystem::SweepHitbox(FAttackWindow& Window, FHitbox& Hitbox)
+{
+	USkeletalMeshComponent* Mesh = Window.Mesh.Get();
+	ICombatAttacker* Attacker = Window.Attacker.Get();
+
+	if (!Mesh || !Attacker)
+	{
+		return;
+	}
+
+	const FTransform SocketTransform = Mesh->GetSocketTransform(Hitbox.SocketName);
+	const FVector CurrentLocation = SocketTransform.GetLocation();
+
+	// sweeping a shape between the two locations covers the whole path travelled this frame
+	const FCollisionShape Shape = Hitbox.HalfHeight > Hitbox.Radius ? FCollisionShape::MakeCapsule(Hitbox.Radius, Hitbox.HalfHeight) : FCollisionShape::MakeSphere(Hitbox.Radius);
+
+	// ignore the attacker itself
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatHitbox), false, Mesh->GetOwner());
+
+	GetWorld()->AsyncSweepByObjectType(EAsyncTraceType::Multi, Hitbox.LastLocation, CurrentLocation, SocketTransform.GetRotation(), Attacker->GetAttackObjectTypes(), Shape, QueryParams, &SweepDelegate, Window.Serial);
+
+	++Window.PendingSweeps;
+	Hitbox.LastLocation = CurrentLocation;
+}
+
+void UCombatHitboxSubsystem::OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FAttackWindow* Window = AttackWindows.FindByPredicate([Serial = Datum.UserData](const FAttackWindow& Current) { return Current.Serial == Serial; });
+
+	if (!Window)
+	{
+		return;
+	}
+
+	--Window->PendingSweeps;
+
+	ICombatAttacker* Attacker = Window->Attacker.Get();
+
+	if (!Attacker)
+	{
+		return;
+	}
+
+	// deduplicate against everything this window already hit. Several components of the same actor may be in the results
+	TArray<const FHitResult*, TInlineAllocator<4>> NewHits;
+
+	for (const FHitResult& Hit : Datum.OutHits)
+	{
+		AActor* HitActor = Hit.GetActor();
+
+		if (!HitActor || Window->HitActors.Contains(HitActor))
+		{
+			continue;
+		}
+
+		Window->HitActors.Add(HitActor);
+		NewHits.Add(&Hit);
+	}
+
+	// apply the hits once we're done with the window, since hit handling may open or close other windows
+	for (const FHitResult* Hit : NewHits)
+	{
+		Attacker->ApplyAttackHit(*Hit);
+	}
+}
+
+void UCombatHitboxSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SweepDelegate.BindUObject(this, &UCombatHitboxSubsystem::OnSweepCompleted);
+}
+
+void UCombatHitboxSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (int32 i = AttackWindows.Num() - 1; i >= 0; --i)
+	{
+		FAttackWindow& Window = AttackWindows[i];
+
+		// close windows whose mesh or attacker went away
+		if (!Window.Mesh.IsValid() || !Window.Attacker.IsValid())
+		{
+			Window.Hitboxes.Reset();
+			Window.bClosed = true;
+		}
+
+		// sweep every open hitbox along its path since last frame
+		for (FHitbox& Hitbox : Window.Hitboxes)
+		{
+			SweepHitbox(Window, Hitbox);
+		}
+
+		// drop closed windows once all their results are in
+		if (Window.bClosed && Window.PendingSweeps <= 0)
+		{
+			AttackWindows.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+}
+
+TStatId UCombatHitboxSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatHitboxSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatHitboxSubsystem::Deinitialize()
+{
+	AttackWindows.Empty();
+	SweepDelegate.Unbind();
+
+	Super::Deinitialize();
+}
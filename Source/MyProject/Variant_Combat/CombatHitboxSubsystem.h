@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "UObject/WeakInterfacePtr.h"
+#include "CombatAttacker.h"
+#include "CombatHitboxSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+/**
+ *  Runs swept hitboxes for melee attack windows.
+ *  While a window is open, each hitbox sweeps its shape along the socket's path since the last frame,
+ *  so fast swings can't skip over targets. Sweeps for all attackers are issued together as async
+ *  scene queries once per frame, and their results are applied on the next frame.
+ *  Each target is only reported once per attack window, even if several hitboxes touch it.
+ */
+UCLASS()
+class UCombatHitboxSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** A single hitbox attached to a mesh socket */
+	struct FHitbox
+	{
+		/** Socket the hitbox follows */
+		FName SocketName;
+
+		/** Radius of the hitbox shape */
+		float Radius = 0.0f;
+
+		/** Half height of the hitbox capsule, aligned with the socket's Z axis. Spheres are used if not above the radius */
+		float HalfHeight = 0.0f;
+
+		/** Socket location at the last sweep */
+		FVector LastLocation = FVector::ZeroVector;
+	};
+
+	/** An attack window for a single attacker */
+	struct FAttackWindow
+	{
+		/** Identifies this window in async sweep results */
+		uint32 Serial = 0;
+
+		/** Mesh the hitboxes are attached to */
+		TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+		/** Attacker receiving the hits */
+		TWeakInterfacePtr<ICombatAttacker> Attacker;
+
+		/** Currently open hitboxes. The window closes once the last one ends */
+		TArray<FHitbox, TInlineAllocator<2>> Hitboxes;
+
+		/** Actors already hit during this window */
+		TArray<TWeakObjectPtr<AActor>, TInlineAllocator<4>> HitActors;
+
+		/** Number of sweeps issued but not yet completed */
+		int32 PendingSweeps = 0;
+
+		/** Set once all hitboxes have ended. Kept around until pending sweeps complete */
+		bool bClosed = false;
+	};
+
+	/** Active attack windows */
+	TArray<FAttackWindow> AttackWindows;
+
+	/** Serial for the next attack window */
+	uint32 NextSerial = 1;
+
+	/** Delegate called when a hitbox sweep completes */
+	FTraceDelegate SweepDelegate;
+
+public:
+
+	/** Opens a hitbox on the mesh socket. Starts a new attack window if the mesh doesn't have one open */
+	void BeginHitbox(USkeletalMeshComponent* Mesh, FName SocketName, float Radius, float HalfHeight);
+
+	/** Sweeps the last stretch of the hitbox and closes it. Closes the attack window if this was its last hitbox */
+	void EndHitbox(USkeletalMeshComponent* Mesh, FName SocketName);
+
+protected:
+
+	/** Returns the open attack window for the mesh, or nullptr */
+	FAttackWindow* FindOpenWindow(const USkeletalMeshComponent* Mesh);
+
+	/** Issues an async sweep from the hitbox's last location to its current one */
+	void SweepHitbox(FAttackWindow& Window, FHitbox& Hitbox);
+
+	/** Applies the hits from a completed sweep to the window's attacker */
+	void OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+public:
+
+	/** Binds the sweep delegate */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Sweeps all open hitboxes */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+};
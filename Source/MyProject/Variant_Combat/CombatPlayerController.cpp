@@ -7,6 +7,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/PlayerStart.h"
 #include "CombatCharacter.h"
+#include "CombatCheckpointSubsystem.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "Blueprint/UserWidget.h"
@@ -20,20 +21,8 @@ void ACombatPlayerController::BeginPlay()
 	// only spawn touch controls on local player controllers
 	if (ShouldUseTouchControls() && IsLocalPlayerController())
 	{
-		// spawn the mobile controls widget
-		MobileControlsWidget = CreateWidget<UUserWidget>(this, MobileControlsWidgetClass);
-
-		if (MobileControlsWidget)
-		{
-			// add the controls to the player screen
-			MobileControlsWidget->AddToPlayerScreen(0);
-
-		} else {
-
-			UE_LOG(LogMyProject, Error, TEXT("Could not spawn mobile controls widget."));
-
-		}
-
+		// load and spawn the mobile controls widget
+		MobileControls.Load(this, MobileControlsWidgetClass);
 	}
 }
 
@@ -78,8 +67,28 @@ void ACombatPlayerController::SetRespawnTransform(const FTransform& NewRespawn)
 	RespawnTransform = NewRespawn;
 }
 
+void ACombatPlayerController::RespawnCharacter(ACombatCharacter* DeadCharacter)
+{
+	// roll the world back to the last checkpoint
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->RestoreSnapshot();
+	}
+
+	// reuse the existing character instead of spawning a new one
+	DeadCharacter->ResetForRespawn(RespawnTransform);
+
+	SetControlRotation(RespawnTransform.Rotator());
+}
+
 void ACombatPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
 {
+	// roll the world back to the last checkpoint
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->RestoreSnapshot();
+	}
+
 	// spawn a new character at the respawn transform
 	if (ACombatCharacter* RespawnedCharacter = GetWorld()->SpawnActor<ACombatCharacter>(CharacterClass, RespawnTransform))
 	{
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "MobileControlsLoader.h"
 #include "CombatPlayerController.generated.h"
 
 class UInputMappingContext;
@@ -12,7 +13,8 @@ class ACombatCharacter;
 /**
  *  Simple Player Controller for a third person combat game
  *  Manages input mappings
- *  Respawns the player character at the checkpoint when it's destroyed
+ *  Respawns the player character at the checkpoint when it dies, resetting it in place
+ *  Spawns a new character if the possessed one is destroyed
  */
 UCLASS(abstract, Config="Game")
 class ACombatPlayerController : public APlayerController
@@ -29,13 +31,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input|Input Mappings")
 	TArray<UInputMappingContext*> MobileExcludedMappingContexts;
 
-	/** Mobile controls widget to spawn */
+	/** Mobile controls widget to spawn. Soft referenced so it's only loaded when touch controls are in use, asynchronously if enabled in the Asset Loading settings */
 	UPROPERTY(EditAnywhere, Category="Input|Touch Controls")
-	TSubclassOf<UUserWidget> MobileControlsWidgetClass;
+	TSoftClassPtr<UUserWidget> MobileControlsWidgetClass;
 
-	/** Pointer to the mobile controls widget */
+	/** Loads and spawns the mobile controls widget */
 	UPROPERTY()
-	TObjectPtr<UUserWidget> MobileControlsWidget;
+	FMobileControlsLoader MobileControls;
 
 	/** If true, the player will use UMG touch controls even if not playing on mobile platforms */
 	UPROPERTY(EditAnywhere, Config, Category = "Input|Touch Controls")
@@ -64,6 +66,9 @@ public:
 	/** Updates the character respawn transform */
 	void SetRespawnTransform(const FTransform& NewRespawn);
 
+	/** Restores the last checkpoint and resets the dead character in place at the respawn transform */
+	void RespawnCharacter(ACombatCharacter* DeadCharacter);
+
 protected:
 
 	/** Called if the possessed pawn is destroyed */
@@ -0,0 +1,18 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GenericTeamAgentInterface.h"
+
+/**
+ *  Team IDs for combat characters.
+ *  Characters on different teams are hostile to each other through the default team attitude solver.
+ */
+namespace CombatTeams
+{
+	/** Player characters */
+	inline const FGenericTeamId Player(0);
+
+	/** AI enemies */
+	inline const FGenericTeamId Enemy(1);
+}
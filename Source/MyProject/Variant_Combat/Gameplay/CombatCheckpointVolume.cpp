@@ -4,6 +4,8 @@
 #include "CombatCheckpointVolume.h"
 #include "CombatCharacter.h"
 #include "CombatPlayerController.h"
+#include "CombatCheckpointSubsystem.h"
+#include "Engine/World.h"
 
 ACombatCheckpointVolume::ACombatCheckpointVolume()
 {
@@ -41,6 +43,12 @@ void ACombatCheckpointVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent
 
 			// update the player's respawn checkpoint
 			PC->SetRespawnTransform(PlayerCharacter->GetActorTransform());
+
+			// snapshot the world state so it can be restored when the player respawns
+			if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+			{
+				Checkpoints->CaptureSnapshot();
+			}
 		}
 
 	}
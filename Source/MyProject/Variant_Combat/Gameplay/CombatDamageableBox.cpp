@@ -3,7 +3,7 @@
 
 #include "CombatDamageableBox.h"
 #include "Components/StaticMeshComponent.h"
-#include "TimerManager.h"
+#include "CombatCheckpointSubsystem.h"
 #include "Engine/World.h"
 
 ACombatDamageableBox::ACombatDamageableBox()
@@ -13,8 +13,8 @@ ACombatDamageableBox::ACombatDamageableBox()
 	// create the mesh
 	RootComponent = Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 
-	// set the collision properties
-	Mesh->SetCollisionProfileName(FName("BlockAllDynamic"));
+	// set the collision properties. Hurtboxes block like dynamic objects, but are on their own object channel for attack sweeps
+	Mesh->SetCollisionProfileName(FName("CombatHurtbox"));
 
 	// enable physics
 	Mesh->SetSimulatePhysics(true);
@@ -25,16 +25,37 @@ ACombatDamageableBox::ACombatDamageableBox()
 
 void ACombatDamageableBox::RemoveFromLevel()
 {
-	// destroy this actor
-	Destroy();
+	// hide and disable the box instead of destroying it, so checkpoints can bring it back without respawning it
+	Mesh->SetSimulatePhysics(false);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
+void ACombatDamageableBox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// let checkpoints save and restore our state
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->RegisterActor(this);
+	}
 }
 
 void ACombatDamageableBox::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the death timer
-	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	// cancel the death timer
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->CancelAll(this);
+	}
+
+	if (UCombatCheckpointSubsystem* Checkpoints = GetWorld()->GetSubsystem<UCombatCheckpointSubsystem>())
+	{
+		Checkpoints->UnregisterActor(this);
+	}
 }
 
 void ACombatDamageableBox::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
@@ -68,7 +89,10 @@ void ACombatDamageableBox::HandleDeath()
 	OnBoxDestroyed();
 
 	// set up the death cleanup timer
-	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &ACombatDamageableBox::RemoveFromLevel, DeathDelayTime);
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Reschedule(DeathTimer, this, DeathDelayTime, &ACombatDamageableBox::RemoveFromLevel);
+	}
 }
 
 void ACombatDamageableBox::ApplyHealing(float Healing, AActor* Healer)
@@ -81,3 +105,42 @@ void ACombatDamageableBox::NotifyDanger(const FVector& DangerLocation, AActor* D
 	// stub
 }
 
+void ACombatDamageableBox::SaveCheckpointState(FArchive& Ar)
+{
+	FTransform Transform = GetActorTransform();
+
+	Ar << CurrentHP;
+	Ar << Transform;
+}
+
+void ACombatDamageableBox::LoadCheckpointState(FArchive& Ar)
+{
+	FTransform Transform;
+
+	Ar << CurrentHP;
+	Ar << Transform;
+
+	// cancel any pending removal
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Cancel(DeathTimer);
+	}
+
+	// boxes that were already destroyed at the checkpoint stay removed
+	if (CurrentHP <= 0.0f)
+	{
+		RemoveFromLevel();
+		return;
+	}
+
+	// bring the box back with its original collision and a clean physics state
+	Mesh->SetCollisionProfileName(FName("CombatHurtbox"));
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	Mesh->SetSimulatePhysics(true);
+	Mesh->SetPhysicsLinearVelocity(FVector::ZeroVector);
+	Mesh->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+}
@@ -5,13 +5,16 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatDamageable.h"
+#include "CombatCheckpointable.h"
+#include "GameplaySchedulerSubsystem.h"
 #include "CombatDamageableBox.generated.h"
 
 /**
  *  A simple physics box that reacts to damage through the ICombatDamageable interface
+ *  Destroyed boxes are hidden rather than removed, so checkpoints can restore them in place
  */
 UCLASS(abstract)
-class ACombatDamageableBox : public AActor, public ICombatDamageable
+class ACombatDamageableBox : public AActor, public ICombatDamageable, public ICombatCheckpointable
 {
 	GENERATED_BODY()
 	
@@ -35,7 +38,7 @@ protected:
 	float DeathDelayTime = 6.0f;
 
 	/** Timer to defer destruction of this box after its HP are depleted */
-	FTimerHandle DeathTimer;
+	FGameplayScheduleHandle DeathTimer;
 
 	/** Blueprint damage handler for effect playback */
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
@@ -45,11 +48,14 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
 	void OnBoxDestroyed();
 
-	/** Timer callback to remove the box from the level after it dies */
+	/** Timer callback to remove the box from the level after it dies. The box is hidden and disabled, but not destroyed */
 	void RemoveFromLevel();
 
 public:
 
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
 	/** EndPlay cleanup */
 	void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
@@ -68,4 +74,14 @@ public:
 	virtual void NotifyDanger(const FVector& DangerLocation, AActor* DangerSource) override;
 
 	// ~End CombatDamageable interface
+
+	// ~Begin CombatCheckpointable interface
+
+	/** Saves the box's HP and transform */
+	virtual void SaveCheckpointState(FArchive& Ar) override;
+
+	/** Restores the box's HP and transform, bringing it back if it was destroyed since */
+	virtual void LoadCheckpointState(FArchive& Ar) override;
+
+	// ~End CombatCheckpointable interface
 };
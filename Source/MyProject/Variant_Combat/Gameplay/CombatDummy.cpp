@@ -22,6 +22,7 @@ ACombatDummy::ACombatDummy()
 	Dummy = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Dummy"));
 	Dummy->SetupAttachment(RootComponent);
 
+	Dummy->SetCollisionProfileName(FName("CombatHurtbox"));
 	Dummy->SetSimulatePhysics(true);
 
 	// create the physics constraint
@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "CombatFlowFieldVolume.h"
+#include "CombatFlowFieldSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+
+ACombatFlowFieldVolume::ACombatFlowFieldVolume()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// create the box volume
+	RootComponent = Box = CreateDefaultSubobject<UBoxComponent>(TEXT("Box"));
+	check(Box);
+
+	// set the box's extent
+	Box->SetBoxExtent(FVector(2000.0f, 2000.0f, 500.0f));
+
+	// the box only defines the arena bounds
+	Box->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Box->SetCanEverAffectNavigation(false);
+}
+
+void ACombatFlowFieldVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UCombatFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UCombatFlowFieldSubsystem>())
+	{
+		FlowFields->RegisterArena(this);
+	}
+}
+
+void ACombatFlowFieldVolume::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UCombatFlowFieldSubsystem>())
+	{
+		FlowFields->UnregisterArena(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CombatFlowFieldVolume.generated.h"
+
+class UBoxComponent;
+
+/**
+ *  Defines a combat arena covered by a player-centered flow field.
+ *  Enemies inside the volume steer along the flow field towards the player instead of pathfinding individually.
+ *  The field is built over the navmesh in the volume's XY bounds when play begins.
+ */
+UCLASS()
+class ACombatFlowFieldVolume : public AActor
+{
+	GENERATED_BODY()
+
+	/** Arena bounds */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* Box;
+
+protected:
+
+	/** Size of each flow field cell. Smaller cells follow tighter geometry but cost more to update */
+	UPROPERTY(EditAnywhere, Category="Flow Field", meta = (ClampMin = 25, ClampMax = 500, Units = "cm"))
+	float CellSize = 100.0f;
+
+	/** Max height difference between neighboring cells for them to be connected */
+	UPROPERTY(EditAnywhere, Category="Flow Field", meta = (ClampMin = 0, ClampMax = 500, Units = "cm"))
+	float MaxStepHeight = 60.0f;
+
+	/** Max number of cells processed each frame while the field is updated for a new player location */
+	UPROPERTY(EditAnywhere, Category="Flow Field", meta = (ClampMin = 64, ClampMax = 65536))
+	int32 MaxCellsPerFrame = 2048;
+
+public:
+
+	/** Constructor */
+	ACombatFlowFieldVolume();
+
+	/** Returns the arena bounds box */
+	UBoxComponent* GetBox() const { return Box; }
+
+	/** Returns the flow field cell size */
+	float GetCellSize() const { return CellSize; }
+
+	/** Returns the max height difference between connected cells */
+	float GetMaxStepHeight() const { return MaxStepHeight; }
+
+	/** Returns the number of cells processed each frame during updates */
+	int32 GetMaxCellsPerFrame() const { return MaxCellsPerFrame; }
+
+protected:
+
+	/** Registers the arena with the flow field subsystem */
+	virtual void BeginPlay() override;
+
+	/** Unregisters the arena */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+};
@@ -6,6 +6,9 @@
 #include "UObject/Interface.h"
 #include "CombatAttacker.generated.h"
 
+struct FHitResult;
+struct FCollisionObjectQueryParams;
+
 /**
  *  CombatAttacker Interface
  *  Provides common functionality to trigger attack animation events.
@@ -33,4 +36,10 @@ public:
 	/** Performs a charged attack's check to loop the charge animation. Usually called from a montage's AnimNotify */
 	UFUNCTION(BlueprintCallable, Category="Attacker")
 	virtual void CheckChargedAttack() = 0;
+
+	/** Returns the collision object types this attacker's hitboxes can hit */
+	virtual FCollisionObjectQueryParams GetAttackObjectTypes() const = 0;
+
+	/** Applies the attack to a target hit by one of this attacker's hitboxes. Each target is only reported once per attack window */
+	virtual void ApplyAttackHit(const FHitResult& Hit) = 0;
 };
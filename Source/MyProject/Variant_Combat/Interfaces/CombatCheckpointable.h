@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "CombatCheckpointable.generated.h"
+
+/**
+ *  CombatCheckpointable interface
+ *  Provides functionality to save an actor's gameplay state into a checkpoint snapshot
+ *  and to restore it in place, without recreating the actor
+ */
+UINTERFACE(MinimalAPI, NotBlueprintable)
+class UCombatCheckpointable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class ICombatCheckpointable
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Writes the actor's checkpoint state to the archive */
+	virtual void SaveCheckpointState(FArchive& Ar) = 0;
+
+	/** Restores the actor from the state written by SaveCheckpointState */
+	virtual void LoadCheckpointState(FArchive& Ar) = 0;
+
+	/** Called on actors that weren't part of the snapshot, such as enemies spawned after it was taken */
+	virtual void RestoreMissingCheckpointState() {}
+
+	/** Called on every checkpointable actor once all of them have been restored */
+	virtual void PostCheckpointRestored() {}
+};
@@ -11,16 +11,15 @@
 #include "Camera/CameraComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedInputComponent.h"
-#include "TimerManager.h"
 #include "Engine/LocalPlayer.h"
+#include "CharacterTraversalComponent.h"
+#include "InputBufferComponent.h"
 
 APlatformingCharacter::APlatformingCharacter()
 {
  	PrimaryActorTick.bCanEverTick = true;
 
 	// initialize the flags
-	bHasWallJumped = false;
-	bHasDoubleJumped = false;
 	bHasDashed = false;
 	bIsDashing = false;
 
@@ -40,23 +39,27 @@ APlatformingCharacter::APlatformingCharacter()
 	bUseControllerRotationYaw = false;
 	
 	// Configure character movement
-	GetCharacterMovement()->GravityScale = 2.5f;
-	GetCharacterMovement()->MaxAcceleration = 1500.0f;
-	GetCharacterMovement()->BrakingFrictionFactor = 1.0f;
-	GetCharacterMovement()->bUseSeparateBrakingFriction = true;
+	FCharacterMovementProfile DefaultMovementProfile;
 
-	GetCharacterMovement()->GroundFriction = 4.0f;
-	GetCharacterMovement()->MaxWalkSpeed = 750.0f;
-	GetCharacterMovement()->MinAnalogWalkSpeed = 20.0f;
-	GetCharacterMovement()->BrakingDecelerationWalking = 2500.0f;
-	GetCharacterMovement()->PerchRadiusThreshold = 15.0f;
+	DefaultMovementProfile.GravityScale = 2.5f;
+	DefaultMovementProfile.MaxAcceleration = 1500.0f;
+	DefaultMovementProfile.BrakingFrictionFactor = 1.0f;
+	DefaultMovementProfile.bUseSeparateBrakingFriction = true;
 
-	GetCharacterMovement()->JumpZVelocity = 350.0f;
-	GetCharacterMovement()->BrakingDecelerationFalling = 750.0f;
-	GetCharacterMovement()->AirControl = 1.0f;
+	DefaultMovementProfile.GroundFriction = 4.0f;
+	DefaultMovementProfile.MaxWalkSpeed = 750.0f;
+	DefaultMovementProfile.MinAnalogWalkSpeed = 20.0f;
+	DefaultMovementProfile.BrakingDecelerationWalking = 2500.0f;
+	DefaultMovementProfile.PerchRadiusThreshold = 15.0f;
 
-	GetCharacterMovement()->RotationRate = FRotator(0.0f, 500.0f, 0.0f);
-	GetCharacterMovement()->bOrientRotationToMovement = true;
+	DefaultMovementProfile.JumpZVelocity = 350.0f;
+	DefaultMovementProfile.BrakingDecelerationFalling = 750.0f;
+	DefaultMovementProfile.AirControl = 1.0f;
+
+	DefaultMovementProfile.RotationRate = FRotator(0.0f, 500.0f, 0.0f);
+	DefaultMovementProfile.bOrientRotationToMovement = true;
+
+	DefaultMovementProfile.ApplyTo(GetCharacterMovement());
 
 	GetCharacterMovement()->NavAgentProps.AgentRadius = 42.0;
 	GetCharacterMovement()->NavAgentProps.AgentHeight = 192.0;
@@ -76,6 +79,15 @@ APlatformingCharacter::APlatformingCharacter()
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
+
+	// create the input buffer
+	InputBuffer = CreateDefaultSubobject<UInputBufferComponent>(TEXT("InputBuffer"));
+
+	// create the traversal component
+	Traversal = CreateDefaultSubobject<UCharacterTraversalComponent>(TEXT("Traversal"));
+
+	// activate the jump trail whenever we jump
+	Traversal->OnTraversalJump.AddUObject(this, &APlatformingCharacter::OnTraversalJump);
 }
 
 void APlatformingCharacter::Move(const FInputActionValue& Value)
@@ -107,95 +119,14 @@ void APlatformingCharacter::MultiJump()
 	if(bIsDashing)
 		return;
 
-	// are we already in the air?
-	if (GetCharacterMovement()->IsFalling())
-	{
-
-		// have we already wall jumped?
-		if (!bHasWallJumped)
-		{
-			// run a sphere sweep to check if we're in front of a wall
-			FHitResult OutHit;
-
-			const FVector TraceStart = GetActorLocation();
-			const FVector TraceEnd = TraceStart + (GetActorForwardVector() * WallJumpTraceDistance);
-			const FCollisionShape TraceShape = FCollisionShape::MakeSphere(WallJumpTraceRadius);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(this);
-
-			if (GetWorld()->SweepSingleByChannel(OutHit, TraceStart, TraceEnd, FQuat(), ECollisionChannel::ECC_Visibility, TraceShape, QueryParams))
-			{
-				// rotate the character to face away from the wall, so we're correctly oriented for the next wall jump
-				FRotator WallOrientation = OutHit.ImpactNormal.ToOrientationRotator();
-				WallOrientation.Pitch = 0.0f;
-				WallOrientation.Roll = 0.0f;
-
-				SetActorRotation(WallOrientation);
-
-				// apply a launch impulse to the character to perform the actual wall jump
-				const FVector WallJumpImpulse = (OutHit.ImpactNormal * WallJumpBounceImpulse) + (FVector::UpVector * WallJumpVerticalImpulse);
-
-				LaunchCharacter(WallJumpImpulse, true, true);
-
-				// enable the jump trail
-				SetJumpTrailState(true);
-
-				// raise the wall jump flag to prevent an immediate second wall jump
-				bHasWallJumped = true;
-
-				GetWorld()->GetTimerManager().SetTimer(WallJumpTimer, this, &APlatformingCharacter::ResetWallJump, DelayBetweenWallJumps, false);
-			}
-			// no wall jump, try a double jump next
-			else
-			{
-				// are we still within coyote time frames?
-				if (GetWorld()->GetTimeSeconds() - LastFallTime < MaxCoyoteTime)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("Coyote Jump"));
-
-					// use the built-in CMC functionality to do the jump
-					Jump();
-
-					// enable the jump trail
-					SetJumpTrailState(true);
-
-				// no coyote time jump
-				} else {
-
-					// only double jump once while we're in the air
-					if (!bHasDoubleJumped)
-					{
-						bHasDoubleJumped = true;
-
-						// use the built-in CMC functionality to do the double jump
-						Jump();
-
-						// enable the jump trail
-						SetJumpTrailState(true);
-					}
-
-				}
-
-				
-			}
-		}
-
-	}
-	else
-	{
-		// we're grounded so just do a regular jump
-		Jump();
-
-		// activate the jump trail
-		SetJumpTrailState(true);
-	}
+	// let the traversal component pick the best jump
+	Traversal->TryJump();
 }
 
-void APlatformingCharacter::ResetWallJump()
+void APlatformingCharacter::OnTraversalJump(ETraversalJumpType JumpType)
 {
-	// reset the wall jump input lock
-	bHasWallJumped = false;
+	// enable the jump trail
+	SetJumpTrailState(true);
 }
 
 void APlatformingCharacter::DoMove(float Right, float Forward)
@@ -203,7 +134,7 @@ void APlatformingCharacter::DoMove(float Right, float Forward)
 	if (GetController() != nullptr)
 	{
 		// momentarily disable movement inputs if we've just wall jumped
-		if (!bHasWallJumped)
+		if (!Traversal->HasWallJumped())
 		{
 			// find out which way is forward
 			const FRotator Rotation = GetController()->GetControlRotation();
@@ -242,8 +173,18 @@ void APlatformingCharacter::DoDash()
 	bIsDashing = true;
 	bHasDashed = true;
 
-	// disable gravity while dashing
-	GetCharacterMovement()->GravityScale = 0.0f;
+	// save the current movement values so we can restore them after the dash
+	PreDashMovementProfile = FCharacterMovementProfile::CaptureFrom(GetCharacterMovement());
+
+	// switch to the dash movement profile. If we don't have one, dash with the current values and gravity disabled
+	if (DashProfile)
+	{
+		DashProfile->Profile.ApplyTo(GetCharacterMovement());
+
+	} else {
+
+		GetCharacterMovement()->GravityScale = 0.0f;
+	}
 
 	// reset the character velocity so we don't carry momentum into the dash
 	GetCharacterMovement()->Velocity = FVector::ZeroVector;
@@ -284,8 +225,8 @@ void APlatformingCharacter::DashMontageEnded(UAnimMontage* Montage, bool bInterr
 
 void APlatformingCharacter::EndDash()
 {
-	// restore gravity
-	GetCharacterMovement()->GravityScale = 2.5f;
+	// restore the movement values from before the dash
+	PreDashMovementProfile.ApplyTo(GetCharacterMovement());
 
 	// reset the dashing flag
 	bIsDashing = false;
@@ -303,20 +244,31 @@ void APlatformingCharacter::EndDash()
 
 bool APlatformingCharacter::HasDoubleJumped() const
 {
-	return bHasDoubleJumped;
+	return Traversal->HasDoubleJumped();
 }
 
 bool APlatformingCharacter::HasWallJumped() const
 {
-	return bHasWallJumped;
+	return Traversal->HasWallJumped();
 }
 
-void APlatformingCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+void APlatformingCharacter::BeginPlay()
 {
-	Super::EndPlay(EndPlayReason);
-
-	// clear the wall jump reset timer
-	GetWorld()->GetTimerManager().ClearTimer(WallJumpTimer);
+	Super::BeginPlay();
+
+	// pass our wall jump and coyote time tuning to the traversal component
+	Traversal->WallProbeDistance = WallJumpTraceDistance;
+	Traversal->WallProbeRadius = WallJumpTraceRadius;
+	Traversal->WallJumpHorizontalImpulse = WallJumpBounceImpulse;
+	Traversal->WallJumpVerticalImpulse = WallJumpVerticalImpulse;
+	Traversal->DelayBetweenWallJumps = DelayBetweenWallJumps;
+	Traversal->MaxCoyoteTime = MaxCoyoteTime;
+
+	// apply the movement profile override, if any
+	if (MovementProfile)
+	{
+		MovementProfile->Profile.ApplyTo(GetCharacterMovement());
+	}
 }
 
 void APlatformingCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -345,23 +297,21 @@ void APlatformingCharacter::Landed(const FHitResult& Hit)
 {
 	Super::Landed(Hit);
 
-	// reset the double jump and dash flags
-	bHasDoubleJumped = false;
+	// reset the dash flag
 	bHasDashed = false;
 
 	// deactivate the jump trail
 	SetJumpTrailState(false);
+
+	// reset the double jump
+	Traversal->HandleLanded();
 }
 
 void APlatformingCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode /*= 0*/)
 {
 	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
 
-	// are we falling?
-	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling)
-	{
-		// save the game time when we started falling, so we can check it later for coyote time jumps
-		LastFallTime = GetWorld()->GetTimeSeconds();
-	}
+	// keep track of coyote time and replay any buffered jump once we land
+	Traversal->HandleMovementModeChanged();
 }
 
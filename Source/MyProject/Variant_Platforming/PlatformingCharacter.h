@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Animation/AnimInstance.h"
+#include "CharacterMovementProfile.h"
 #include "PlatformingCharacter.generated.h"
 
 
@@ -13,6 +14,9 @@ class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
 class UAnimMontage;
+class UCharacterTraversalComponent;
+class UInputBufferComponent;
+enum class ETraversalJumpType : uint8;
 
 /**
  *  An enhanced Third Person Character with the following functionality:
@@ -34,6 +38,14 @@ class APlatformingCharacter : public ACharacter
 	/** Follow camera */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
+
+	/** Handles wall jumps, coyote time, double jumps and jump buffering */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UCharacterTraversalComponent* Traversal;
+
+	/** Buffers jump inputs that couldn't be used in the air */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UInputBufferComponent* InputBuffer;
 	
 protected:
 
@@ -76,8 +88,8 @@ protected:
 	/** Called for jump pressed to check for advanced multi-jump conditions */
 	void MultiJump();
 
-	/** Resets the wall jump input lock */
-	void ResetWallJump();
+	/** Called from a delegate when the traversal component performs a jump */
+	void OnTraversalJump(ETraversalJumpType JumpType);
 
 public:
 
@@ -126,9 +138,9 @@ public:
 	bool HasWallJumped() const;
 
 public:	
-	
-	/** EndPlay cleanup */
-	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
 
 	/** Sets up input action bindings */
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -142,17 +154,23 @@ public:
 protected:
 
 	/** movement state flag bits, packed into a uint8 for memory efficiency */
-	uint8 bHasWallJumped : 1;
-	uint8 bHasDoubleJumped : 1;
 	uint8 bHasDashed : 1;
 	uint8 bIsDashing : 1;
 
-	/** timer for wall jump input reset */
-	FTimerHandle WallJumpTimer;
-
 	/** Dash montage ended delegate */
 	FOnMontageEnded OnDashMontageEnded;
 
+	/** Optional movement profile override. If unset, the character movement component values are used */
+	UPROPERTY(EditAnywhere, Category="Movement Profile")
+	UCharacterMovementProfileAsset* MovementProfile;
+
+	/** Optional movement profile to use while dashing. If unset, the current movement values are used with gravity disabled */
+	UPROPERTY(EditAnywhere, Category="Movement Profile")
+	UCharacterMovementProfileAsset* DashProfile;
+
+	/** Movement values captured when the dash started, restored when it ends */
+	FCharacterMovementProfile PreDashMovementProfile;
+
 	/** Distance to trace ahead of the character to look for walls to jump from */
 	UPROPERTY(EditAnywhere, Category="Wall Jump", meta = (ClampMin = 0, ClampMax = 1000, Units = "cm"))
 	float WallJumpTraceDistance = 50.0f;
@@ -177,9 +195,6 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Dash")
 	UAnimMontage* DashMontage;
 
-	/** Last recorded time when this character started falling */
-	float LastFallTime = 0.0f;
-
 	/** Max amount of time that can pass since we started falling when we allow a regular jump */
 	UPROPERTY(EditAnywhere, Category="Coyote Time", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
 	float MaxCoyoteTime = 0.16f;
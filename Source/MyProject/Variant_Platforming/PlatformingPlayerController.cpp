@@ -20,20 +20,8 @@ void APlatformingPlayerController::BeginPlay()
 	// only spawn touch controls on local player controllers
 	if (ShouldUseTouchControls() && IsLocalPlayerController())
 	{
-		// spawn the mobile controls widget
-		MobileControlsWidget = CreateWidget<UUserWidget>(this, MobileControlsWidgetClass);
-
-		if (MobileControlsWidget)
-		{
-			// add the controls to the player screen
-			MobileControlsWidget->AddToPlayerScreen(0);
-
-		} else {
-
-			UE_LOG(LogMyProject, Error, TEXT("Could not spawn mobile controls widget."));
-
-		}
-
+		// load and spawn the mobile controls widget
+		MobileControls.Load(this, MobileControlsWidgetClass);
 	}
 }
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "MobileControlsLoader.h"
 #include "PlatformingPlayerController.generated.h"
 
 class UInputMappingContext;
@@ -29,13 +30,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input|Input Mappings")
 	TArray<UInputMappingContext*> MobileExcludedMappingContexts;
 
-	/** Mobile controls widget to spawn */
+	/** Mobile controls widget to spawn. Soft referenced so it's only loaded when touch controls are in use, asynchronously if enabled in the Asset Loading settings */
 	UPROPERTY(EditAnywhere, Category="Input|Touch Controls")
-	TSubclassOf<UUserWidget> MobileControlsWidgetClass;
+	TSoftClassPtr<UUserWidget> MobileControlsWidgetClass;
 
-	/** Pointer to the mobile controls widget */
+	/** Loads and spawns the mobile controls widget */
 	UPROPERTY()
-	TObjectPtr<UUserWidget> MobileControlsWidget;
+	FMobileControlsLoader MobileControls;
 
 	/** If true, the player will use UMG touch controls even if not playing on mobile platforms */
 	UPROPERTY(EditAnywhere, Config, Category = "Input|Touch Controls")
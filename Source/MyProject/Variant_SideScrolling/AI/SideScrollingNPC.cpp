@@ -4,21 +4,43 @@
 #include "SideScrollingNPC.h"
 #include "Engine/World.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "TimerManager.h"
+#include "AnimationBudgetSubsystem.h"
+#include "SkeletalMeshComponentBudgeted.h"
 
-ASideScrollingNPC::ASideScrollingNPC()
+ASideScrollingNPC::ASideScrollingNPC(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
  	PrimaryActorTick.bCanEverTick = true;
 
 	GetCharacterMovement()->MaxWalkSpeed = 150.0f;
 }
 
+void ASideScrollingNPC::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// let the animation budget throttle our mesh based on significance
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->RegisterMesh(GetMesh());
+	}
+}
+
 void ASideScrollingNPC::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the deactivation timer
-	GetWorld()->GetTimerManager().ClearTimer(DeactivationTimer);
+	// cancel the deactivation timer
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->CancelAll(this);
+	}
+
+	// stop tracking our mesh's significance
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->UnregisterMesh(GetMesh());
+	}
 }
 
 void ASideScrollingNPC::Interaction(AActor* Interactor)
@@ -43,7 +65,10 @@ void ASideScrollingNPC::Interaction(AActor* Interactor)
 	LaunchCharacter(LaunchVector, true, true);
 
 	// set up a timer to schedule reactivation
-	GetWorld()->GetTimerManager().SetTimer(DeactivationTimer, this, &ASideScrollingNPC::ResetDeactivation, DeactivationTime, false);
+	if (UGameplaySchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UGameplaySchedulerSubsystem>())
+	{
+		Scheduler->Reschedule(DeactivationTimer, this, DeactivationTime, &ASideScrollingNPC::ResetDeactivation);
+	}
 }
 
 void ASideScrollingNPC::ResetDeactivation()
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "SideScrollingInteractable.h"
+#include "GameplaySchedulerSubsystem.h"
 #include "SideScrollingNPC.generated.h"
 
 /**
@@ -38,15 +39,18 @@ public:
 	bool bDeactivated = false;
 
 	/** Timer to reactivate the NPC */
-	FTimerHandle DeactivationTimer;
+	FGameplayScheduleHandle DeactivationTimer;
 
 public:
 
-	/** Constructor */
-	ASideScrollingNPC();
+	/** Constructor. Uses a budgeted skeletal mesh so animation can be throttled by the animation budget allocator */
+	ASideScrollingNPC(const FObjectInitializer& ObjectInitializer);
 
 public:
 
+	/** Initialization */
+	virtual void BeginPlay() override;
+
 	/** Cleanup */
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
@@ -3,9 +3,9 @@
 
 #include "SideScrollingJumpPad.h"
 #include "Components/BoxComponent.h"
-#include "GameFramework/Character.h"
-#include "GameFramework/CharacterMovementComponent.h"
 #include "Components/SceneComponent.h"
+#include "SideScrollingCharacterMovementComponent.h"
+#include "MyProjectCollisionChannels.h"
 
 ASideScrollingJumpPad::ASideScrollingJumpPad()
 {
@@ -22,25 +22,14 @@ ASideScrollingJumpPad::ASideScrollingJumpPad()
 	Box->SetBoxExtent(FVector(115.0f, 90.0f, 20.0f), false);
 	Box->SetRelativeLocation(FVector(0.0f, 0.0f, 16.0f));
 
-	Box->SetCollisionObjectType(ECC_WorldDynamic);
+	// block pawns so characters can stand on the pad and find it as their floor.
+	// Launch surfaces are ignored by default, so pawns that can't be launched walk through the pad instead of standing on it
+	Box->SetCollisionObjectType(ECC_LaunchSurface);
 	Box->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 	Box->SetCollisionResponseToAllChannels(ECR_Ignore);
-	Box->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+	Box->SetCollisionResponseToChannel(ECC_Pawn, ECR_Block);
+	Box->SetGenerateOverlapEvents(false);
 
-	// add the overlap handler
-	OnActorBeginOverlap.AddDynamic(this, &ASideScrollingJumpPad::BeginOverlap);
-}
-
-void ASideScrollingJumpPad::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
-{
-	// were we overlapped by a character?
-	if (ACharacter* OverlappingCharacter = Cast<ACharacter>(OtherActor))
-	{
-		// force the character to jump
-		OverlappingCharacter->Jump();
-
-		// launch the character to override its vertical velocity
-		FVector LaunchVelocity = FVector::UpVector * ZStrength;
-		OverlappingCharacter->LaunchCharacter(LaunchVelocity, false, true);
-	}
+	// mark the box as a launch surface
+	Box->ComponentTags.Add(USideScrollingCharacterMovementComponent::LaunchSurfaceTag);
 }
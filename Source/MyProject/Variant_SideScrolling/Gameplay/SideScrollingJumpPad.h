@@ -4,19 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "SideScrollingLaunchSurface.h"
 #include "SideScrollingJumpPad.generated.h"
 
 class UBoxComponent;
 
 /**
  *  A simple jump pad that launches characters into the air
+ *  The pad is a tagged launch surface. Characters find it during their floor checks and launch themselves,
+ *  so the pad doesn't generate overlap events.
  */
 UCLASS(abstract)
-class ASideScrollingJumpPad : public AActor
+class ASideScrollingJumpPad : public AActor, public ISideScrollingLaunchSurface
 {
 	GENERATED_BODY()
 	
-	/** Jump pad bounding box */
+	/** Jump pad surface */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UBoxComponent* Box;
 
@@ -31,9 +34,10 @@ public:
 	/** Constructor */
 	ASideScrollingJumpPad();
 
-protected:
+// ~begin ISideScrollingLaunchSurface interface
 
-	UFUNCTION()
-	void BeginOverlap(AActor* OverlappedActor, AActor* OtherActor);
+	/** Returns the velocity to launch characters standing on the pad with */
+	virtual FVector GetLaunchVelocity(const UPrimitiveComponent* Surface) const override { return FVector::UpVector * ZStrength; }
 
+// ~end ISideScrollingLaunchSurface interface
 };
@@ -3,6 +3,9 @@
 
 #include "SideScrollingMovingPlatform.h"
 #include "Components/SceneComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "PlatformMoverComponent.h"
 
 ASideScrollingMovingPlatform::ASideScrollingMovingPlatform()
 {
@@ -10,6 +13,74 @@ ASideScrollingMovingPlatform::ASideScrollingMovingPlatform()
 
 	// create the root comp
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	// create the interaction volume
+	InteractionVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("Interaction Volume"));
+	InteractionVolume->SetupAttachment(RootComponent);
+
+	InteractionVolume->SetBoxExtent(FVector(100.0f, 100.0f, 100.0f));
+	InteractionVolume->SetCollisionProfileName(FName("Interactable"));
+
+	// create the platform mover
+	Mover = CreateDefaultSubobject<UPlatformMoverComponent>(TEXT("Mover"));
+}
+
+void ASideScrollingMovingPlatform::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	if (bFitInteractionVolume)
+	{
+		FitInteractionVolume();
+	}
+}
+
+void ASideScrollingMovingPlatform::FitInteractionVolume()
+{
+	FBox LocalBounds(ForceInit);
+
+	// combine the bounds of the platform meshes in actor space
+	ForEachComponent<UPrimitiveComponent>(false, [this, &LocalBounds](UPrimitiveComponent* Primitive)
+	{
+		if (Primitive != InteractionVolume && Primitive->IsRegistered())
+		{
+			const FTransform ComponentToActor = Primitive->GetComponentTransform().GetRelativeTransform(GetActorTransform());
+			LocalBounds += Primitive->CalcBounds(ComponentToActor).GetBox();
+		}
+	});
+
+	// keep the default size if there's nothing to fit to
+	if (!LocalBounds.IsValid)
+	{
+		return;
+	}
+
+	InteractionVolume->SetRelativeLocationAndRotation(LocalBounds.GetCenter(), FRotator::ZeroRotator);
+	InteractionVolume->SetBoxExtent(LocalBounds.GetExtent() + FVector(InteractionVolumePadding));
+}
+
+void ASideScrollingMovingPlatform::BeginPlay()
+{
+	if (bNativeMovement)
+	{
+		// move straight to the target if the mover doesn't have its own path.
+		// Set this up before Super so the mover builds its path from it
+		if (Mover->PathPoints.IsEmpty() && !Mover->bUseSpline)
+		{
+			Mover->PathPoints.Add(GetActorTransform().InverseTransformPosition(PlatformTarget));
+			Mover->Duration = MoveDuration;
+		}
+
+		Mover->OnMoveFinished.AddDynamic(this, &ASideScrollingMovingPlatform::OnMoveFinished);
+	}
+
+	Super::BeginPlay();
+}
+
+void ASideScrollingMovingPlatform::OnMoveFinished()
+{
+	// allow the platform to be triggered again
+	ResetInteraction();
 }
 
 void ASideScrollingMovingPlatform::Interaction(AActor* Interactor)
@@ -23,8 +94,16 @@ void ASideScrollingMovingPlatform::Interaction(AActor* Interactor)
 	// raise the movement flag
 	bMoving = true;
 
-	// pass control to BP for the actual movement
-	BP_MoveToTarget();
+	if (bNativeMovement)
+	{
+		// move to the other end of the path
+		Mover->Play();
+
+	} else {
+
+		// pass control to BP for the actual movement
+		BP_MoveToTarget();
+	}
 }
 
 void ASideScrollingMovingPlatform::ResetInteraction()
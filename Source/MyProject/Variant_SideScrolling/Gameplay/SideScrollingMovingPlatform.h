@@ -7,14 +7,26 @@
 #include "SideScrollingInteractable.h"
 #include "SideScrollingMovingPlatform.generated.h"
 
+class UBoxComponent;
+class UPlatformMoverComponent;
+
 /**
  *  Simple moving platform that can be triggered through interactions by other actors.
- *  The actual movement is performed by Blueprint code through latent execution nodes.
+ *  Movement is left to Blueprint code by default. Platforms can opt into native movement, where a platform mover
+ *  moves the actor to the target and back on alternate interactions.
  */
 UCLASS(abstract)
 class ASideScrollingMovingPlatform : public AActor, public ISideScrollingInteractable
 {
 	GENERATED_BODY()
+
+	/** Query only volume found by interaction sweeps */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* InteractionVolume;
+
+	/** Moves the platform along its path */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UPlatformMoverComponent* Mover;
 	
 public:	
 	
@@ -38,6 +50,33 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Moving Platform")
 	bool bOneShot = false;
 
+	/** If true, the platform is moved by the platform mover. If the mover has no path, it moves straight to the platform target. Otherwise, movement is left to Blueprint through Move to Target */
+	UPROPERTY(EditAnywhere, Category="Moving Platform")
+	bool bNativeMovement = false;
+
+	/** If true, the interaction volume is fitted to the bounds of the platform's other primitive components. Otherwise its size is left as set in Blueprint */
+	UPROPERTY(EditAnywhere, Category="Interaction")
+	bool bFitInteractionVolume = true;
+
+	/** Extra space added around the platform bounds when fitting the interaction volume */
+	UPROPERTY(EditAnywhere, Category="Interaction", meta = (ClampMin = 0, ClampMax = 500, Units="cm", EditCondition="bFitInteractionVolume"))
+	float InteractionVolumePadding = 10.0f;
+
+protected:
+
+	/** Fits the interaction volume to the platform */
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+	/** Fits the interaction volume to the combined local bounds of the platform's other primitive components */
+	void FitInteractionVolume();
+
+	/** Sets up the mover path */
+	virtual void BeginPlay() override;
+
+	/** Resets the interaction once the mover stops */
+	UFUNCTION()
+	void OnMoveFinished();
+
 public:
 
 // ~begin IInteractable interface 
@@ -53,7 +92,7 @@ public:
 
 protected:
 
-	/** Allows Blueprint code to do the actual platform movement */
+	/** Allows Blueprint code to do the actual platform movement when native movement is disabled */
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category="Moving Platform", meta = (DisplayName="Move to Target"))
 	void BP_MoveToTarget();
 
@@ -2,14 +2,14 @@
 
 
 #include "SideScrollingSoftPlatform.h"
+#include "Components/BoxComponent.h"
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
-#include "Components/BoxComponent.h"
-#include "SideScrollingCharacter.h"
+#include "MyProjectCollisionChannels.h"
 
 ASideScrollingSoftPlatform::ASideScrollingSoftPlatform()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+ 	PrimaryActorTick.bCanEverTick = false;
 
 	// create the root component
 	RootComponent = Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -19,41 +19,23 @@ ASideScrollingSoftPlatform::ASideScrollingSoftPlatform()
 	Mesh->SetupAttachment(Root);
 
 	Mesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-	Mesh->SetCollisionObjectType(ECC_WorldStatic);
+	Mesh->SetCollisionObjectType(ECC_SoftPlatform);
 	Mesh->SetCollisionResponseToAllChannels(ECR_Block);
 
-	// create the collision check box
-	CollisionCheckBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Collision Check Box"));
-	CollisionCheckBox->SetupAttachment(Mesh);
-
-	CollisionCheckBox->SetRelativeLocation(FVector(0.0f, 0.0f, -40.0f));
-	CollisionCheckBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-	CollisionCheckBox->SetCollisionObjectType(ECC_WorldDynamic);
-	CollisionCheckBox->SetCollisionResponseToAllChannels(ECR_Ignore);
-	CollisionCheckBox->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
-
-	// subscribe to the overlap events
-	CollisionCheckBox->OnComponentBeginOverlap.AddDynamic(this, &ASideScrollingSoftPlatform::OnSoftCollisionOverlap);
+	// one way collision is resolved by character movement, so we don't need overlap events
+	Mesh->SetGenerateOverlapEvents(false);
 }
 
-void ASideScrollingSoftPlatform::OnSoftCollisionOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void ASideScrollingSoftPlatform::PostLoad()
 {
-	// have we overlapped a character?
-	if (ASideScrollingCharacter* Char = Cast<ASideScrollingCharacter>(OtherActor))
+	// platforms saved before the collision check box was removed still carry it and its overrides.
+	// Detach it and move it out of the actor before the owned components are gathered, so it's never registered and isn't saved again
+	if (CollisionCheckBox_DEPRECATED)
 	{
-		// disable the soft collision channel
-		Char->SetSoftCollision(true);
+		CollisionCheckBox_DEPRECATED->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+		CollisionCheckBox_DEPRECATED->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_ForceNoResetLoaders);
+		CollisionCheckBox_DEPRECATED = nullptr;
 	}
-}
 
-void ASideScrollingSoftPlatform::NotifyActorEndOverlap(AActor* OtherActor)
-{
-	Super::NotifyActorEndOverlap(OtherActor);
-
-	// have we overlapped a character?
-	if (ASideScrollingCharacter* Char = Cast<ASideScrollingCharacter>(OtherActor))
-	{
-		// enable the soft collision channel
-		Char->SetSoftCollision(false);
-	}
+	Super::PostLoad();
 }
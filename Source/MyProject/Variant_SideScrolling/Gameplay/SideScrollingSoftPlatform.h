@@ -6,12 +6,14 @@
 #include "GameFramework/Actor.h"
 #include "SideScrollingSoftPlatform.generated.h"
 
+class UBoxComponent;
 class USceneComponent;
 class UStaticMeshComponent;
-class UBoxComponent;
 
 /**
  *  A side scrolling game platform that the character can jump or drop through.
+ *  The platform only sets its mesh to the soft platform object type. Passing through it is handled
+ *  by the character's movement component, so the platform doesn't tick or generate overlaps.
  */
 UCLASS(abstract)
 class ASideScrollingSoftPlatform : public AActor
@@ -26,21 +28,15 @@ class ASideScrollingSoftPlatform : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
 
-	/** Collision volume that toggles soft collision on the character when they're below the platform. */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
-	UBoxComponent* CollisionCheckBox;
+	/** Overlap box from before one way platforms moved into character movement. Only loaded so saved instances can drop it */
+	UPROPERTY()
+	UBoxComponent* CollisionCheckBox_DEPRECATED;
 
 public:	
 	
 	/** Constructor */
 	ASideScrollingSoftPlatform();
 
-protected:
-
-	/** Handles soft collision check box overlaps */
-	UFUNCTION()
-	void OnSoftCollisionOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	/** Restores soft collision state when overlap ends */
-	virtual void NotifyActorEndOverlap(AActor* OtherActor) override;
+	/** Removes the obsolete collision check box from platforms saved with it */
+	virtual void PostLoad() override;
 };
@@ -0,0 +1,6 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingLaunchSurface.h"
+
+// Add default functionality here for any ISideScrollingLaunchSurface functions that are not pure virtual.
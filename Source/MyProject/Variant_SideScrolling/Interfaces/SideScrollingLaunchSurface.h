@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "SideScrollingLaunchSurface.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ *  
+ */
+UINTERFACE(MinimalAPI, NotBlueprintable)
+class USideScrollingLaunchSurface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ *  Implemented by Actors owning launch surfaces, so they can provide the launch velocity for each tagged surface.
+ *  Launch surfaces whose owner doesn't implement this use the movement component's default launch speed.
+ */
+class ISideScrollingLaunchSurface
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the velocity to launch characters standing on the provided surface with */
+	virtual FVector GetLaunchVelocity(const UPrimitiveComponent* Surface) const = 0;
+
+};
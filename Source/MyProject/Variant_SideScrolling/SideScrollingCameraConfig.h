@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SideScrollingCameraConfig.generated.h"
+
+/**
+ *  Tuning values for the side scrolling camera.
+ *  Shared between levels so the camera feel can be adjusted without touching code.
+ */
+UCLASS(BlueprintType)
+class USideScrollingCameraConfig : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Field of view of the side scrolling camera */
+	UPROPERTY(EditAnywhere, Category="View", meta=(ClampMin=5, ClampMax=170, Units="deg"))
+	float FieldOfView = 65.0f;
+
+	/** Yaw of the side scrolling camera. -90 looks down the positive Y axis */
+	UPROPERTY(EditAnywhere, Category="View", meta=(ClampMin=-180, ClampMax=180, Units="deg"))
+	float CameraYaw = -90.0f;
+
+	/** How far above the target do we want the camera to focus */
+	UPROPERTY(EditAnywhere, Category="View", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float CameraZOffset = 100.0f;
+
+	/** Interpolation speed used to blend the camera location towards its goal */
+	UPROPERTY(EditAnywhere, Category="Interpolation", meta=(ClampMin=0, ClampMax=100))
+	float LocationInterpSpeed = 2.0f;
+
+	/** Interpolation speed used to blend the camera height towards the target */
+	UPROPERTY(EditAnywhere, Category="Interpolation", meta=(ClampMin=0, ClampMax=100))
+	float HeightInterpSpeed = 2.0f;
+
+	/** While grounded, the camera snaps its height goal if it's within this distance of the cached height */
+	UPROPERTY(EditAnywhere, Category="Interpolation", meta=(ClampMin=0, ClampMax=1000, Units="cm"))
+	float GroundedHeightTolerance = 25.0f;
+
+	/** The camera snaps its height goal to the target if it's within this distance */
+	UPROPERTY(EditAnywhere, Category="Interpolation", meta=(ClampMin=0, ClampMax=1000, Units="cm"))
+	float HeightSnapTolerance = 100.0f;
+
+	/** Max distance below the target to look for ground while airborne */
+	UPROPERTY(EditAnywhere, Category="Ground Cache", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float GroundTraceDistance = 1000.0f;
+
+	/** Max horizontal half width of a cached ground footprint, so large floors and slopes get refreshed */
+	UPROPERTY(EditAnywhere, Category="Ground Cache", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float MaxGroundFootprintHalfWidth = 500.0f;
+
+	/** Horizontal half width of the footprint cached when no ground was found below the target */
+	UPROPERTY(EditAnywhere, Category="Ground Cache", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float NoGroundFootprintHalfWidth = 100.0f;
+
+	/** Vertical distance the target must fall after a missed ground trace before tracing again */
+	UPROPERTY(EditAnywhere, Category="Ground Cache", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float NoGroundRetraceHeight = 250.0f;
+
+	/** Extra space to keep around the local players when framing all of them in a shared view */
+	UPROPERTY(EditAnywhere, Category="Multiplayer Framing", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
+	float FramingPadding = 300.0f;
+
+	/** Max camera distance for the shared view. Local players split into split-screen views past this distance */
+	UPROPERTY(EditAnywhere, Category="Multiplayer Framing", meta=(ClampMin=0, ClampMax=100000, Units="cm"))
+	float MaxSharedZoom = 2500.0f;
+
+	/** Fraction of the max shared zoom the framing must fall under before split-screen views merge back */
+	UPROPERTY(EditAnywhere, Category="Multiplayer Framing", meta=(ClampMin=0, ClampMax=1))
+	float MergeZoomFraction = 0.8f;
+};
@@ -2,11 +2,24 @@
 
 
 #include "SideScrollingCameraManager.h"
-#include "GameFramework/Pawn.h"
+#include "SideScrollingCameraConfig.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/GameViewportClient.h"
 #include "Engine/HitResult.h"
 #include "CollisionQueryParams.h"
 #include "Engine/World.h"
 
+ASideScrollingCameraManager::ASideScrollingCameraManager()
+{
+	// initialize the ground cache flags
+	bGroundCacheValid = false;
+	bCachedGroundHit = false;
+}
+
 void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
 {
 	// ensure the view target is a pawn
@@ -15,9 +28,18 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 	// is our target valid?
 	if (IsValid(TargetPawn))
 	{
+		// use the class defaults if we don't have a config asset
+		const USideScrollingCameraConfig* Config = CameraConfig ? CameraConfig : GetDefault<USideScrollingCameraConfig>();
+
 		// set the view target FOV and rotation
-		OutVT.POV.Rotation = FRotator(0.0f, -90.0f, 0.0f);
-		OutVT.POV.FOV = 65.0f;
+		OutVT.POV.Rotation = FRotator(0.0f, Config->CameraYaw, 0.0f);
+		OutVT.POV.FOV = Config->FieldOfView;
+
+		// frame all local players together if they're close enough to share a view
+		if (UpdateSharedViewTarget(OutVT, DeltaTime, Config))
+		{
+			return;
+		}
 
 		// cache the current location
 		FVector CurrentActorLocation = OutVT.Target->GetActorLocation();
@@ -37,7 +59,7 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 			// initialize the camera viewpoint and return
 			OutVT.POV.Location.X = CurrentActorLocation.X;
 			OutVT.POV.Location.Y = CurrentY;
-			OutVT.POV.Location.Z = CurrentActorLocation.Z + CameraZOffset;
+			OutVT.POV.Location.Z = CurrentActorLocation.Z + Config->CameraZOffset;
 
 			// save the current camera height
 			CurrentZ = OutVT.POV.Location.Z;
@@ -53,20 +75,12 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 		if (FMath::IsNearlyZero(TargetPawn->GetVelocity().Z))
 		{
 			// determine if we need to do a height update
-			bZUpdate = FMath::IsNearlyEqual(CurrentZ, CurrentCameraLocation.Z, 25.0f);
+			bZUpdate = FMath::IsNearlyEqual(CurrentZ, CurrentCameraLocation.Z, Config->GroundedHeightTolerance);
 
 		} else {
 
-			// run a trace below the character to determine if we need to do a height update
-			FHitResult OutHit;
-
-			const FVector End = CurrentActorLocation + FVector(0.0f, 0.0f, -1000.0f);
-
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(TargetPawn);
-
 			// only update height if we're not about to hit ground
-			bZUpdate = !GetWorld()->LineTraceSingleByChannel(OutHit, CurrentActorLocation, End, ECC_Visibility, QueryParams);
+			bZUpdate = !IsGroundBelow(TargetPawn, CurrentActorLocation, Config);
 
 		}
 
@@ -80,7 +94,7 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 		} else {
 
 			// are we close enough to the target height?
-			if (FMath::IsNearlyEqual(CurrentZ, CurrentActorLocation.Z, 100.0f))
+			if (FMath::IsNearlyEqual(CurrentZ, CurrentActorLocation.Z, Config->HeightSnapTolerance))
 			{
 				// set the height goal from the actor location
 				CurrentZ = CurrentActorLocation.Z;
@@ -88,8 +102,8 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 			} else {
 
 				// blend the height towards the actor location
-				CurrentZ = FMath::FInterpTo(CurrentZ, CurrentActorLocation.Z, DeltaTime, 2.0f);
-				
+				CurrentZ = FMath::FInterpTo(CurrentZ, CurrentActorLocation.Z, DeltaTime, Config->HeightInterpSpeed);
+
 			}
 
 		}
@@ -100,6 +114,200 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 		// blend towards the new camera location and update the output
 		FVector TargetCameraLocation(CurrentX, CurrentY, CurrentZ);
 
-		OutVT.POV.Location = FMath::VInterpTo(CurrentCameraLocation, TargetCameraLocation, DeltaTime, 2.0f);
+		OutVT.POV.Location = FMath::VInterpTo(CurrentCameraLocation, TargetCameraLocation, DeltaTime, Config->LocationInterpSpeed);
+	}
+}
+
+bool ASideScrollingCameraManager::UpdateSharedViewTarget(FTViewTarget& OutVT, float DeltaTime, const USideScrollingCameraConfig* Config)
+{
+	UWorld* World = GetWorld();
+
+	// accumulate the bounds of all local player pawns. This runs every frame, so avoid any allocations
+	FBox PlayerBounds(ForceInit);
+	int32 NumPlayers = 0;
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			if (const APawn* PlayerPawn = PlayerController->GetPawn())
+			{
+				PlayerBounds += PlayerPawn->GetActorLocation();
+				++NumPlayers;
+			}
+		}
+	}
+
+	// nothing to frame for a single player
+	if (NumPlayers < 2)
+	{
+		return false;
+	}
+
+	UGameViewportClient* ViewportClient = World->GetGameViewport();
+
+	// get the aspect ratio of the full, unsplit viewport
+	float AspectRatio = 16.0f / 9.0f;
+
+	if (ViewportClient)
+	{
+		FVector2D ViewportSize;
+		ViewportClient->GetViewportSize(ViewportSize);
+
+		if (ViewportSize.Y > 0.0f)
+		{
+			AspectRatio = ViewportSize.X / ViewportSize.Y;
+		}
+	}
+
+	// find the camera distance that fits the padded player bounds both horizontally and vertically
+	const FVector Extent = PlayerBounds.GetExtent();
+	const float TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(Config->FieldOfView * 0.5f));
+
+	const float HorizontalFit = (Extent.X + Config->FramingPadding) / TanHalfFOV;
+	const float VerticalFit = (Extent.Z + Config->FramingPadding) * AspectRatio / TanHalfFOV;
+
+	const float FitZoom = FMath::Max3(CurrentZoom, HorizontalFit, VerticalFit);
+
+	// the first local player owns the split-screen decision, everyone else follows the viewport state
+	const UGameInstance* GameInstance = GetGameInstance();
+
+	if (GameInstance && PCOwner == GameInstance->GetFirstLocalPlayerController(World))
+	{
+		// split when the players get too far apart, merge again once they're comfortably close
+		if (!bSplitViews && FitZoom > Config->MaxSharedZoom)
+		{
+			bSplitViews = true;
+
+		} else if (bSplitViews && FitZoom < Config->MaxSharedZoom * Config->MergeZoomFraction) {
+
+			bSplitViews = false;
+		}
+
+		// only touch the viewport when the state actually changes
+		if (ViewportClient && ViewportClient->IsSplitscreenForceDisabled() == bSplitViews)
+		{
+			ViewportClient->SetForceDisableSplitscreen(!bSplitViews);
+		}
+
+	} else if (ViewportClient) {
+
+		bSplitViews = !ViewportClient->IsSplitscreenForceDisabled();
+	}
+
+	// split views use the regular single target camera
+	if (bSplitViews)
+	{
+		return false;
+	}
+
+	// center the shared view on the player bounds
+	const FVector Center = PlayerBounds.GetCenter();
+
+	const FVector TargetCameraLocation(FMath::Clamp(Center.X, CameraXMinBounds, CameraXMaxBounds), Center.Y + FitZoom, Center.Z + Config->CameraZOffset);
+
+	// snap on the first update, blend afterwards
+	if (bSetup)
+	{
+		bSetup = false;
+
+		OutVT.POV.Location = TargetCameraLocation;
+
+	} else {
+
+		OutVT.POV.Location = FMath::VInterpTo(GetCameraLocation(), TargetCameraLocation, DeltaTime, Config->LocationInterpSpeed);
+	}
+
+	// keep the height goal in sync so splitting back into single views blends smoothly
+	CurrentZ = OutVT.POV.Location.Z;
+
+	return true;
+}
+
+bool ASideScrollingCameraManager::IsGroundBelow(APawn* TargetPawn, const FVector& TargetLocation, const USideScrollingCameraConfig* Config)
+{
+	// invalidate the cache if the view target changed
+	if (CachedGroundTarget.Get() != TargetPawn)
+	{
+		CachedGroundTarget = TargetPawn;
+		bGroundCacheValid = false;
+	}
+
+	// if the character movement is standing on a walkable floor, reuse its floor result instead of tracing
+	if (const ACharacter* TargetCharacter = Cast<ACharacter>(TargetPawn))
+	{
+		const FFindFloorResult& CurrentFloor = TargetCharacter->GetCharacterMovement()->CurrentFloor;
+
+		if (CurrentFloor.IsWalkableFloor())
+		{
+			CacheGround(CurrentFloor.HitResult, Config);
+		}
+	}
+
+	// we've dropped below the cached ground, such as into a pit inside the ground's bounds, so it no longer applies
+	if (bGroundCacheValid && bCachedGroundHit && TargetLocation.Z < CachedGroundZ)
+	{
+		bGroundCacheValid = false;
+	}
+
+	// are we still inside the cached footprint?
+	bool bNeedsTrace = !bGroundCacheValid || TargetLocation.X < CachedGroundMinX || TargetLocation.X > CachedGroundMaxX;
+
+	// if we didn't find ground last time, trace again once we've fallen far enough for it to come into range
+	if (!bNeedsTrace && !bCachedGroundHit)
+	{
+		bNeedsTrace = TargetLocation.Z < NoGroundTraceZ - Config->NoGroundRetraceHeight;
+	}
+
+	if (bNeedsTrace)
+	{
+		// run a trace below the character to refresh the ground cache
+		FHitResult OutHit;
+
+		const FVector End = TargetLocation + FVector(0.0f, 0.0f, -Config->GroundTraceDistance);
+
+		FCollisionQueryParams QueryParams;
+		QueryParams.AddIgnoredActor(TargetPawn);
+
+		if (GetWorld()->LineTraceSingleByChannel(OutHit, TargetLocation, End, ECC_Visibility, QueryParams))
+		{
+			CacheGround(OutHit, Config);
+
+		} else {
+
+			// cache a small footprint with no ground so we don't retrace every frame
+			bGroundCacheValid = true;
+			bCachedGroundHit = false;
+
+			NoGroundTraceZ = TargetLocation.Z;
+			CachedGroundMinX = TargetLocation.X - Config->NoGroundFootprintHalfWidth;
+			CachedGroundMaxX = TargetLocation.X + Config->NoGroundFootprintHalfWidth;
+		}
+	}
+
+	// is the cached ground within range below us?
+	return bCachedGroundHit && TargetLocation.Z >= CachedGroundZ && TargetLocation.Z - CachedGroundZ <= Config->GroundTraceDistance;
+}
+
+void ASideScrollingCameraManager::CacheGround(const FHitResult& GroundHit, const USideScrollingCameraConfig* Config)
+{
+	bGroundCacheValid = true;
+	bCachedGroundHit = true;
+
+	CachedGroundZ = GroundHit.ImpactPoint.Z;
+
+	// start with the max footprint around the impact point
+	CachedGroundMinX = GroundHit.ImpactPoint.X - Config->MaxGroundFootprintHalfWidth;
+	CachedGroundMaxX = GroundHit.ImpactPoint.X + Config->MaxGroundFootprintHalfWidth;
+
+	// narrow the footprint down to the bounds of the ground component
+	if (const UPrimitiveComponent* GroundComponent = GroundHit.GetComponent())
+	{
+		const FBox GroundBounds = GroundComponent->Bounds.GetBox();
+
+		CachedGroundMinX = FMath::Max(CachedGroundMinX, GroundBounds.Min.X);
+		CachedGroundMaxX = FMath::Min(CachedGroundMaxX, GroundBounds.Max.X);
 	}
-}
\ No newline at end of file
+}
@@ -6,29 +6,53 @@
 #include "Camera/PlayerCameraManager.h"
 #include "SideScrollingCameraManager.generated.h"
 
+class USideScrollingCameraConfig;
+class APawn;
+
 /**
  *  Simple side scrolling camera with smooth scrolling and horizontal bounds
+ *  Frames all local players in a shared view for local co-op, and splits
+ *  into split-screen views when they get too far apart.
+ *  Caches the ground height below the target so it only needs to run
+ *  a physics query when the target leaves the cached ground footprint.
  */
 UCLASS()
 class ASideScrollingCameraManager : public APlayerCameraManager
 {
 	GENERATED_BODY()
-	
+
 public:
 
+	/** Constructor */
+	ASideScrollingCameraManager();
+
 	/** Overrides the default camera view target calculation */
 	virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
 
+protected:
+
+	/** Returns true if there is ground close enough below the target to hold the camera height */
+	bool IsGroundBelow(APawn* TargetPawn, const FVector& TargetLocation, const USideScrollingCameraConfig* Config);
+
+	/**
+	 *  Frames all local player pawns in one shared view.
+	 *  Returns false if there's a single local player or the players are currently split.
+	 */
+	bool UpdateSharedViewTarget(FTViewTarget& OutVT, float DeltaTime, const USideScrollingCameraConfig* Config);
+
+	/** Caches a ground hit along with its horizontal footprint */
+	void CacheGround(const FHitResult& GroundHit, const USideScrollingCameraConfig* Config);
+
 public:
 
+	/** Camera tuning values. If unset, the class defaults are used */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera")
+	USideScrollingCameraConfig* CameraConfig;
+
 	/** How close we want to stay to the view target */
 	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
 	float CurrentZoom = 1000.0f;
 
-	/** How far above the target do we want the camera to focus */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=0, ClampMax=10000, Units="cm"))
-	float CameraZOffset = 100.0f;
-
 	/** Minimum camera scrolling bounds in world space */
 	UPROPERTY(EditAnywhere, Category="Side Scrolling Camera", meta=(ClampMin=-100000, ClampMax=100000, Units="cm"))
 	float CameraXMinBounds = -400.0f;
@@ -42,6 +66,26 @@ protected:
 	/** Last cached camera vertical location. The camera only adjusts its height if necessary. */
 	float CurrentZ = 0.0f;
 
+	/** Cached ground height below the target */
+	float CachedGroundZ = 0.0f;
+
+	/** Horizontal extents of the cached ground footprint */
+	float CachedGroundMinX = 0.0f;
+	float CachedGroundMaxX = 0.0f;
+
+	/** Target height when the last ground trace missed */
+	float NoGroundTraceZ = 0.0f;
+
+	/** Pawn the ground cache was built for */
+	TWeakObjectPtr<APawn> CachedGroundTarget;
+
+	/** ground cache flag bits */
+	uint8 bGroundCacheValid : 1;
+	uint8 bCachedGroundHit : 1;
+
 	/** First-time update camera setup flag */
 	bool bSetup = true;
+
+	/** Set while local players are too far apart to share a view */
+	bool bSplitViews = false;
 };
@@ -2,6 +2,10 @@
 
 
 #include "SideScrollingCharacter.h"
+#include "SideScrollingCharacterMovementComponent.h"
+#include "CharacterMovementProfile.h"
+#include "CharacterTraversalComponent.h"
+#include "InputBufferComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Camera/CameraComponent.h"
@@ -11,10 +15,11 @@
 #include "InputAction.h"
 #include "Engine/World.h"
 #include "SideScrollingInteractable.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "TimerManager.h"
+#include "SideScrollingInteractionSubsystem.h"
+#include "SideScrollingPlayerController.h"
 
-ASideScrollingCharacter::ASideScrollingCharacter()
+ASideScrollingCharacter::ASideScrollingCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USideScrollingCharacterMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -31,40 +36,81 @@ ASideScrollingCharacter::ASideScrollingCharacter()
 	bUseControllerRotationYaw = false;
 
 	// configure the character movement component
-	GetCharacterMovement()->GravityScale = 1.75f;
-	GetCharacterMovement()->MaxAcceleration = 1500.0f;
-	GetCharacterMovement()->BrakingFrictionFactor = 1.0f;
-	GetCharacterMovement()->bUseSeparateBrakingFriction = true;
-	GetCharacterMovement()->Mass = 500.0f;
+	FCharacterMovementProfile DefaultMovementProfile;
 
-	GetCharacterMovement()->SetWalkableFloorAngle(75.0f);
-	GetCharacterMovement()->MaxWalkSpeed = 500.0f;
-	GetCharacterMovement()->MinAnalogWalkSpeed = 20.0f;
-	GetCharacterMovement()->BrakingDecelerationWalking = 2000.0f;
-	GetCharacterMovement()->bIgnoreBaseRotation = true;
+	DefaultMovementProfile.GravityScale = 1.75f;
+	DefaultMovementProfile.MaxAcceleration = 1500.0f;
+	DefaultMovementProfile.BrakingFrictionFactor = 1.0f;
+	DefaultMovementProfile.bUseSeparateBrakingFriction = true;
+	DefaultMovementProfile.Mass = 500.0f;
 
-	GetCharacterMovement()->PerchRadiusThreshold = 15.0f;
-	GetCharacterMovement()->LedgeCheckThreshold = 6.0f;
+	DefaultMovementProfile.WalkableFloorAngle = 75.0f;
+	DefaultMovementProfile.MaxWalkSpeed = 500.0f;
+	DefaultMovementProfile.MinAnalogWalkSpeed = 20.0f;
+	DefaultMovementProfile.BrakingDecelerationWalking = 2000.0f;
+	DefaultMovementProfile.bIgnoreBaseRotation = true;
 
-	GetCharacterMovement()->JumpZVelocity = 750.0f;
-	GetCharacterMovement()->AirControl = 1.0f;
+	DefaultMovementProfile.PerchRadiusThreshold = 15.0f;
+	DefaultMovementProfile.LedgeCheckThreshold = 6.0f;
 
-	GetCharacterMovement()->RotationRate = FRotator(0.0f, 750.0f, 0.0f);
-	GetCharacterMovement()->bOrientRotationToMovement = true;
+	DefaultMovementProfile.JumpZVelocity = 750.0f;
+	DefaultMovementProfile.AirControl = 1.0f;
+
+	DefaultMovementProfile.RotationRate = FRotator(0.0f, 750.0f, 0.0f);
+	DefaultMovementProfile.bOrientRotationToMovement = true;
+
+	DefaultMovementProfile.ApplyTo(GetCharacterMovement());
 
 	GetCharacterMovement()->SetPlaneConstraintNormal(FVector(0.0f, 1.0f, 0.0f));
 	GetCharacterMovement()->bConstrainToPlane = true;
 
 	// enable double jump and coyote time
 	JumpMaxCount = 3;
+
+	// create the input buffer
+	InputBuffer = CreateDefaultSubobject<UInputBufferComponent>(TEXT("InputBuffer"));
+
+	// create the traversal component
+	Traversal = CreateDefaultSubobject<UCharacterTraversalComponent>(TEXT("Traversal"));
+
+	// only probe for walls along the horizontal input, with a line trace
+	Traversal->WallProbeRadius = 0.0f;
+	Traversal->bProbeAlongOwnerForward = false;
 }
 
-void ASideScrollingCharacter::EndPlay(EEndPlayReason::Type EndPlayReason)
+void ASideScrollingCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// apply the movement profile override, if any
+	if (MovementProfile)
+	{
+		MovementProfile->Profile.ApplyTo(GetCharacterMovement());
+	}
+
+	// pass our wall jump and coyote time tuning to the traversal component.
+	// The vertical wall jump impulse scales with the final jump velocity
+	Traversal->WallProbeDistance = WallJumpTraceDistance;
+	Traversal->WallJumpHorizontalImpulse = WallJumpHorizontalImpulse;
+	Traversal->WallJumpVerticalImpulse = GetCharacterMovement()->JumpZVelocity * WallJumpVerticalMultiplier;
+	Traversal->DelayBetweenWallJumps = DelayBetweenWallJumps;
+	Traversal->MaxCoyoteTime = MaxCoyoteTime;
+
+	// keep track of nearby interactive objects
+	if (USideScrollingInteractionSubsystem* Interaction = GetWorld()->GetSubsystem<USideScrollingInteractionSubsystem>())
+	{
+		Interaction->RegisterInteractor(this, InteractionRadius, InteractionQueryInterval);
+	}
+}
+
+void ASideScrollingCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the wall jump timer
-	GetWorld()->GetTimerManager().ClearTimer(WallJumpTimer);
+	if (USideScrollingInteractionSubsystem* Interaction = GetWorld()->GetSubsystem<USideScrollingInteractionSubsystem>())
+	{
+		Interaction->UnregisterInteractor(this);
+	}
 }
 
 void ASideScrollingCharacter::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
@@ -83,6 +129,7 @@ void ASideScrollingCharacter::SetupPlayerInputComponent(class UInputComponent* P
 
 		// Moving
 		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &ASideScrollingCharacter::Move);
+		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Completed, this, &ASideScrollingCharacter::MoveReleased);
 
 		// Dropping from platform
 		EnhancedInputComponent->BindAction(DropAction, ETriggerEvent::Triggered, this, &ASideScrollingCharacter::Drop);
@@ -107,7 +154,7 @@ void ASideScrollingCharacter::NotifyHit(class UPrimitiveComponent* MyComp, AActo
 		// ensure the component is movable and simulating physics
 		if (OtherComp->Mobility == EComponentMobility::Movable && OtherComp->IsSimulatingPhysics())
 		{
-			const FVector PushDir = FVector(ActionValueY > 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f);
+			const FVector PushDir = FVector(LastMoveDirection, 0.0f, 0.0f);
 
 			// push the component away
 			OtherComp->AddImpulse(PushDir * JumpPushImpulse, NAME_None, true);
@@ -118,19 +165,30 @@ void ASideScrollingCharacter::NotifyHit(class UPrimitiveComponent* MyComp, AActo
 void ASideScrollingCharacter::Landed(const FHitResult& Hit)
 {
 	// reset the double jump
-	bHasDoubleJumped = false;
+	Traversal->HandleLanded();
 }
 
 void ASideScrollingCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode /*= 0*/)
 {
 	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
 
-	// are we falling?
-	if (GetCharacterMovement()->MovementMode == EMovementMode::MOVE_Falling)
+	// keep track of coyote time and replay any buffered jump once we land
+	Traversal->HandleMovementModeChanged();
+}
+
+void ASideScrollingCharacter::FellOutOfWorld(const UDamageType& DmgType)
+{
+	// reset in place at the player start if the Player Controller can do it
+	if (ASideScrollingPlayerController* PC = Cast<ASideScrollingPlayerController>(GetController()))
 	{
-		// save the game time when we started falling, so we can check it later for coyote time jumps
-		LastFallTime = GetWorld()->GetTimeSeconds();
+		if (PC->RespawnCharacter(this))
+		{
+			return;
+		}
 	}
+
+	// otherwise destroy the character and let it be respawned
+	Super::FellOutOfWorld(DmgType);
 }
 
 void ASideScrollingCharacter::Move(const FInputActionValue& Value)
@@ -141,6 +199,12 @@ void ASideScrollingCharacter::Move(const FInputActionValue& Value)
 	DoMove(MoveVector.Y);
 }
 
+void ASideScrollingCharacter::MoveReleased(const FInputActionValue& Value)
+{
+	// without horizontal input, stop probing for walls so we can't wall jump
+	Traversal->SetWallProbeDirection(FVector::ZeroVector);
+}
+
 void ASideScrollingCharacter::Drop(const FInputActionValue& Value)
 {
 	// route the input
@@ -156,11 +220,18 @@ void ASideScrollingCharacter::DropReleased(const FInputActionValue& Value)
 void ASideScrollingCharacter::DoMove(float Forward)
 {
 	// is movement temporarily disabled after wall jumping?
-	if (!bHasWallJumped)
+	if (!Traversal->HasWallJumped())
 	{
 		// save the movement values
 		ActionValueY = Forward;
 
+		// remember the last direction we moved in and probe for walls along it
+		if (!FMath::IsNearlyZero(Forward))
+		{
+			LastMoveDirection = Forward > 0.0f ? 1.0f : -1.0f;
+			Traversal->SetWallProbeDirection(FVector(LastMoveDirection, 0.0f, 0.0f));
+		}
+
 		// figure out the movement direction
 		const FVector MoveDir = FVector(1.0f, Forward > 0.0f ? 0.1f : -0.1f, 0.0f);
 
@@ -188,28 +259,11 @@ void ASideScrollingCharacter::DoJumpEnd()
 
 void ASideScrollingCharacter::DoInteract()
 {
-	// do a sphere trace to look for interactive objects
-	FHitResult OutHit;
-
-	const FVector Start = GetActorLocation();
-	const FVector End = Start + FVector(100.0f, 0.0f, 0.0f);
-
-	FCollisionShape ColSphere;
-	ColSphere.SetSphere(InteractionRadius);
-
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	if (GetWorld()->SweepSingleByObjectType(OutHit, Start, End, FQuat::Identity, ObjectParams, ColSphere, QueryParams))
+	// interact with the closest interactive object found by the interaction subsystem
+	if (USideScrollingInteractionSubsystem* Interaction = GetWorld()->GetSubsystem<USideScrollingInteractionSubsystem>())
 	{
-		// have we hit an interactable?
-		if (ISideScrollingInteractable* Interactable = Cast<ISideScrollingInteractable>(OutHit.GetActor()))
+		if (ISideScrollingInteractable* Interactable = Interaction->GetBestCandidate(this))
 		{
-			// interact
 			Interactable->Interaction(this);
 		}
 	}
@@ -220,131 +274,31 @@ void ASideScrollingCharacter::MultiJump()
 	// does the user want to drop to a lower platform?
 	if (DropValue > 0.0f)
 	{
-		CheckForSoftCollision();
-		return;
-	}
-
-	// reset the drop value
-	DropValue = 0.0f;
+		DropValue = 0.0f;
 
-	// if we're grounded, disregard advanced jump logic
-	if (!GetCharacterMovement()->IsFalling())
-	{
-		Jump();
+		// drop through the one way platform we're standing on
+		GetSideScrollingMovement()->DropThroughFloor();
 		return;
 	}
 
-	// if we have a horizontal input, try for wall jump first
-	if (!bHasWallJumped && !FMath::IsNearlyZero(ActionValueY))
-	{
-		// trace ahead of the character for walls
-		FHitResult OutHit;
-
-		const FVector Start = GetActorLocation();
-		const FVector End = Start + (FVector(ActionValueY > 0.0f ? 1.0f : -1.0f, 0.0f, 0.0f) * WallJumpTraceDistance);
-
-		FCollisionQueryParams QueryParams;
-		QueryParams.AddIgnoredActor(this);
-
-		GetWorld()->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, QueryParams);
-
-		if (OutHit.bBlockingHit)
-		{
-			// rotate to the bounce direction
-			const FRotator BounceRot = UKismetMathLibrary::MakeRotFromX(OutHit.ImpactNormal);
-			SetActorRotation(FRotator(0.0f, BounceRot.Yaw, 0.0f));
-
-			// calculate the impulse vector
-			FVector WallJumpImpulse = OutHit.ImpactNormal * WallJumpHorizontalImpulse;
-			WallJumpImpulse.Z = GetCharacterMovement()->JumpZVelocity * WallJumpVerticalMultiplier;
-
-			// launch the character away from the wall
-			LaunchCharacter(WallJumpImpulse, true, true);
-
-			// enable wall jump lockout for a bit
-			bHasWallJumped = true;
-
-			// schedule wall jump lockout reset
-			GetWorld()->GetTimerManager().SetTimer(WallJumpTimer, this, &ASideScrollingCharacter::ResetWallJump, DelayBetweenWallJumps, false);
-
-			return;
-		}
-	}
-
-
-
-	// test for double jump only if we haven't already tested for wall jump
-	if (!bHasWallJumped)
-	{
-		// are we still within coyote time frames?
-		if (GetWorld()->GetTimeSeconds() - LastFallTime < MaxCoyoteTime)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Coyote Jump"));
-
-			// use the built-in CMC functionality to do the jump
-			Jump();
-
-		// no coyote time jump
-		} else {
-		
-			// The movement component handles double jump but we still need to manage the flag for animation
-			if (!bHasDoubleJumped)
-			{
-				// raise the double jump flag
-				bHasDoubleJumped = true;
-
-				// let the CMC handle jump
-				Jump();
-			}
-		}
-	}
-}
-
-void ASideScrollingCharacter::CheckForSoftCollision()
-{
 	// reset the drop value
 	DropValue = 0.0f;
 
-	// trace down 
-	FHitResult OutHit;
-
-	const FVector Start = GetActorLocation();
-	const FVector End = Start + (FVector::DownVector * SoftCollisionTraceDistance);
-
-	FCollisionObjectQueryParams ObjectParams;
-	ObjectParams.AddObjectTypesToQuery(SoftCollisionObjectType);
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-
-	GetWorld()->LineTraceSingleByObjectType(OutHit, Start, End, ObjectParams, QueryParams);
-
-	// did we hit a soft floor?
-	if (OutHit.GetActor())
-	{
-		// drop through the floor
-		SetSoftCollision(true);
-	}
-}
-
-void ASideScrollingCharacter::ResetWallJump()
-{
-	// reset the wall jump flag
-	bHasWallJumped = false;
+	// let the traversal component pick the best jump
+	Traversal->TryJump();
 }
 
-void ASideScrollingCharacter::SetSoftCollision(bool bEnabled)
+USideScrollingCharacterMovementComponent* ASideScrollingCharacter::GetSideScrollingMovement() const
 {
-	// enable or disable collision response to the soft collision channel
-	GetCapsuleComponent()->SetCollisionResponseToChannel(SoftCollisionObjectType, bEnabled ? ECR_Ignore : ECR_Block);
+	return CastChecked<USideScrollingCharacterMovementComponent>(GetCharacterMovement());
 }
 
 bool ASideScrollingCharacter::HasDoubleJumped() const
 {
-	return bHasDoubleJumped;
+	return Traversal->HasDoubleJumped();
 }
 
 bool ASideScrollingCharacter::HasWallJumped() const
 {
-	return bHasWallJumped;
+	return Traversal->HasWallJumped();
 }
@@ -9,6 +9,10 @@
 class UCameraComponent;
 class UInputAction;
 struct FInputActionValue;
+class UCharacterMovementProfileAsset;
+class UCharacterTraversalComponent;
+class UInputBufferComponent;
+class USideScrollingCharacterMovementComponent;
 
 /**
  *  A player-controllable character side scrolling game
@@ -22,6 +26,14 @@ class ASideScrollingCharacter : public ACharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Camera", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* Camera;
 
+	/** Handles wall jumps, coyote time, double jumps and jump buffering */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UCharacterTraversalComponent* Traversal;
+
+	/** Buffers jump inputs that couldn't be used in the air */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UInputBufferComponent* InputBuffer;
+
 protected:
 
 	/** Move Input Action */
@@ -48,6 +60,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Side Scrolling|Interaction")
 	float InteractionRadius = 200.0f;
 
+	/** Time between searches for nearby interactive objects */
+	UPROPERTY(EditAnywhere, Category="Side Scrolling|Interaction", meta = (ClampMin = 0, ClampMax = 1, Units = "s"))
+	float InteractionQueryInterval = 0.1f;
+
 	/** Time to disable input after a wall jump to preserve momentum */
 	UPROPERTY(EditAnywhere, Category="Side Scrolling|Wall Jump")
 	float DelayBetweenWallJumps = 0.3f;
@@ -64,48 +80,38 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Side Scrolling|Wall Jump")
 	float WallJumpVerticalMultiplier = 1.4f;
 
-	/** Collision object type to use for soft collision traces (dropping down floors) */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Soft Platforms")
-	TEnumAsByte<ECollisionChannel> SoftCollisionObjectType;
-
-	/** Distance to trace down during soft collision checks */
-	UPROPERTY(EditAnywhere, Category="Side Scrolling|Soft Platforms")
-	float SoftCollisionTraceDistance = 1000.0f;
-
-	/** Last recorded time when this character started falling */
-	float LastFallTime = 0.0f;
-
 	/** Max amount of time that can pass since we started falling when we allow a regular jump */
 	UPROPERTY(EditAnywhere, Category="Side Scrolling|Coyote Time", meta = (ClampMin = 0, ClampMax = 5, Units = "s"))
 	float MaxCoyoteTime = 0.16f;
 
-	/** Wall jump lockout timer */
-	FTimerHandle WallJumpTimer;
+	/** Optional movement profile override. If unset, the character movement component values are used */
+	UPROPERTY(EditAnywhere, Category="Movement Profile")
+	UCharacterMovementProfileAsset* MovementProfile;
 
 	/** Last captured horizontal movement input value */
 	float ActionValueY = 0.0f;
 
+	/** Sign of the last non-zero horizontal movement input. Used to push objects we bump into */
+	float LastMoveDirection = 1.0f;
+
 	/** Last captured platform drop axis value */
 	float DropValue = 0.0f;
 
-	/** If true, this character has already wall jumped */
-	bool bHasWallJumped = false;
-
-	/** If true, this character has already double jumped */
-	bool bHasDoubleJumped = false;
-
 	/** If true, this character is moving along the side scrolling axis */
 	bool bMovingHorizontally = false;
 
 public:
 	
-	/** Constructor */
-	ASideScrollingCharacter();
+	/** Constructor. Uses a movement component that handles one way platforms */
+	ASideScrollingCharacter(const FObjectInitializer& ObjectInitializer);
 
 protected:
 
+	/** Gameplay initialization */
+	virtual void BeginPlay() override;
+
 	/** Gameplay cleanup */
-	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** Initialize input action bindings */
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -119,11 +125,19 @@ protected:
 	/** Handle movement mode changes to keep track of coyote time jumps */
 	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
 
+public:
+
+	/** Lets the Player Controller reset us at the player start instead of destroying the character */
+	virtual void FellOutOfWorld(const UDamageType& DmgType) override;
+
 protected:
 
 	/** Called for movement input */
 	void Move(const FInputActionValue& Value);
 
+	/** Called for movement input release */
+	void MoveReleased(const FInputActionValue& Value);
+
 	/** Called for drop from platform input */
 	void Drop(const FInputActionValue& Value);
 
@@ -157,18 +171,10 @@ protected:
 	/** Handles advanced jump logic */
 	void MultiJump();
 
-	/** Checks for soft collision with platforms */
-	void CheckForSoftCollision();
-
-	/** Resets wall jump lockout. Called from timer after a wall jump */
-	void ResetWallJump();
-
 public:
 
-	/** Sets the soft collision response. True passes, False blocks */
-	void SetSoftCollision(bool bEnabled);
-
-public:
+	/** Returns the side scrolling movement component */
+	USideScrollingCharacterMovementComponent* GetSideScrollingMovement() const;
 
 	/** Returns true if the character has just double jumped */
 	UFUNCTION(BlueprintPure, Category="Side Scrolling")
@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingCharacterMovementComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "PlatformMoverSubsystem.h"
+#include "SideScrollingLaunchSurface.h"
+#include "GameFramework/Character.h"
+#include "MyProjectCollisionChannels.h"
+#include "Engine/World.h"
+
+namespace SideScrollingMovement
+{
+	/** Max number of one way platforms a single move can pass through */
+	static constexpr int32 MaxPassThroughsPerMove = 4;
+}
+
+const FName USideScrollingCharacterMovementComponent::LaunchSurfaceTag = FName("LaunchSurface");
+
+USideScrollingCharacterMovementComponent::USideScrollingCharacterMovementComponent()
+{
+	OneWayPlatformObjectType = ECC_SoftPlatform;
+}
+
+void USideScrollingCharacterMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// move after moving platforms so we follow our base's position for this frame
+	if (UPlatformMoverSubsystem* Movers = GetWorld()->GetSubsystem<UPlatformMoverSubsystem>())
+	{
+		Movers->AddMovementPrerequisite(PrimaryComponentTick);
+	}
+
+	// launch surfaces are ignored by default. Block them so we can stand on them and get launched
+	if (UpdatedPrimitive)
+	{
+		UpdatedPrimitive->SetCollisionResponseToChannel(ECC_LaunchSurface, ECR_Block);
+	}
+}
+
+bool USideScrollingCharacterMovementComponent::DropThroughFloor()
+{
+	// are we standing on a one way platform?
+	UPrimitiveComponent* Floor = CurrentFloor.HitResult.GetComponent();
+
+	if (!IsMovingOnGround() || !CurrentFloor.IsWalkableFloor() || !IsOneWayPlatform(Floor))
+	{
+		return false;
+	}
+
+	// ignore the platform and start falling through it
+	StartPassingThrough(Floor);
+	SetMovementMode(MOVE_Falling);
+
+	return true;
+}
+
+void USideScrollingCharacterMovementComponent::ClearPassThroughPlatforms()
+{
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Platform : PassThroughPlatforms)
+	{
+		if (UpdatedPrimitive && Platform.IsValid())
+		{
+			UpdatedPrimitive->IgnoreComponentWhenMoving(Platform.Get(), false);
+		}
+	}
+
+	PassThroughPlatforms.Reset();
+}
+
+bool USideScrollingCharacterMovementComponent::IsOneWayPlatform(const UPrimitiveComponent* Component) const
+{
+	return Component && Component->GetCollisionObjectType() == OneWayPlatformObjectType;
+}
+
+bool USideScrollingCharacterMovementComponent::MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit, ETeleportType Teleport)
+{
+	FHitResult LocalHit;
+	FHitResult* Hit = OutHit ? OutHit : &LocalHit;
+
+	bool bMoved = Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, Hit, Teleport);
+
+	if (!bSweep)
+	{
+		return bMoved;
+	}
+
+	// fraction of the original move completed before the last hit
+	float MoveTime = 0.0f;
+
+	for (int32 i = 0; i < SideScrollingMovement::MaxPassThroughsPerMove && ShouldPassThrough(*Hit); ++i)
+	{
+		// ignore the platform and finish the rest of the move
+		StartPassingThrough(Hit->GetComponent());
+
+		MoveTime += (1.0f - MoveTime) * Hit->Time;
+
+		bMoved |= Super::MoveUpdatedComponentImpl(Delta * (1.0f - MoveTime), NewRotation, bSweep, Hit, Teleport);
+	}
+
+	// report any remaining hit relative to the original move
+	if (Hit->bBlockingHit)
+	{
+		Hit->Time = MoveTime + (1.0f - MoveTime) * Hit->Time;
+	}
+
+	return bMoved;
+}
+
+void USideScrollingCharacterMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
+{
+	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+
+	CheckForLaunchSurface();
+
+	if (PassThroughPlatforms.IsEmpty() || !UpdatedPrimitive)
+	{
+		return;
+	}
+
+	// stop ignoring platforms once our bounds are clear of them, so we can land on them again.
+	// Pad the bounds by the floor distance plus this update's fall, since a walking capsule hovers
+	// above its floor and would otherwise clear a platform we just started dropping through
+	const float VerticalPadding = MAX_FLOOR_DIST + FMath::Abs(Velocity.Z) * DeltaSeconds;
+	const FBox CharacterBox = UpdatedPrimitive->Bounds.GetBox().ExpandBy(FVector(0.0f, 0.0f, VerticalPadding));
+
+	for (int32 i = PassThroughPlatforms.Num() - 1; i >= 0; --i)
+	{
+		UPrimitiveComponent* Platform = PassThroughPlatforms[i].Get();
+
+		if (!Platform)
+		{
+			PassThroughPlatforms.RemoveAtSwap(i);
+
+		} else if (!CharacterBox.Intersect(Platform->Bounds.GetBox())) {
+
+			UpdatedPrimitive->IgnoreComponentWhenMoving(Platform, false);
+			PassThroughPlatforms.RemoveAtSwap(i);
+		}
+	}
+}
+
+bool USideScrollingCharacterMovementComponent::ShouldPassThrough(const FHitResult& Hit) const
+{
+	if (!Hit.bBlockingHit || !IsOneWayPlatform(Hit.GetComponent()))
+	{
+		return false;
+	}
+
+	// only the walkable top surface blocks. Pass through hits from below, the sides or while overlapping
+	return Hit.bStartPenetrating || !IsWalkable(Hit);
+}
+
+void USideScrollingCharacterMovementComponent::StartPassingThrough(UPrimitiveComponent* Platform)
+{
+	if (!UpdatedPrimitive || !Platform)
+	{
+		return;
+	}
+
+	UpdatedPrimitive->IgnoreComponentWhenMoving(Platform, true);
+	PassThroughPlatforms.AddUnique(Platform);
+}
+
+void USideScrollingCharacterMovementComponent::CheckForLaunchSurface()
+{
+	// reuse the floor found by this update's floor check
+	if (!CharacterOwner || !IsMovingOnGround() || !CurrentFloor.bBlockingHit)
+	{
+		return;
+	}
+
+	const UPrimitiveComponent* Floor = CurrentFloor.HitResult.GetComponent();
+
+	if (!Floor || !Floor->ComponentHasTag(LaunchSurfaceTag))
+	{
+		return;
+	}
+
+	// let the surface's owner provide its own launch velocity
+	const ISideScrollingLaunchSurface* LaunchSurface = Cast<ISideScrollingLaunchSurface>(Floor->GetOwner());
+	const FVector LaunchVelocity = LaunchSurface ? LaunchSurface->GetLaunchVelocity(Floor) : FVector::UpVector * DefaultLaunchSpeed;
+
+	// force a jump, then override the vertical velocity
+	CharacterOwner->Jump();
+	CharacterOwner->LaunchCharacter(LaunchVelocity, false, true);
+}
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SideScrollingCharacterMovementComponent.generated.h"
+
+/**
+ *  Character movement with one way platforms, resolved during the movement sweeps.
+ *  Platforms of the one way object type block the character normally, but a blocking hit on anything
+ *  other than their walkable top surface adds the platform to the updated component's move ignore list
+ *  and the move continues through it. Platforms are removed from the list once the character has cleared them.
+ *  Only the platforms the character is currently passing through are tracked, so platforms need no tick,
+ *  overlap events or collision response changes, and the cost doesn't grow with the platform count.
+ *  Also ticks after the platform mover batch, so based movement follows platforms for the current frame.
+ *  Floors tagged with LaunchSurfaceTag launch the character when it stands on them, so launch surfaces
+ *  are found by the regular floor check and don't need overlap volumes. Owners implementing ISideScrollingLaunchSurface
+ *  provide the launch velocity, otherwise DefaultLaunchSpeed is used. Only characters using this component block
+ *  the launch surface object channel, so other pawns pass through launch surfaces instead of standing on them.
+ */
+UCLASS()
+class USideScrollingCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+	/** Platforms the character is currently passing through */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>, TInlineAllocator<4>> PassThroughPlatforms;
+
+public:
+
+	/** Component tag marking floors that launch the character */
+	static const FName LaunchSurfaceTag;
+
+	/** Collision object type of the one way platforms */
+	UPROPERTY(EditAnywhere, Category="One Way Platforms")
+	TEnumAsByte<ECollisionChannel> OneWayPlatformObjectType;
+
+	/** Vertical launch speed for launch surfaces that don't provide their own */
+	UPROPERTY(EditAnywhere, Category="Launch Surfaces", meta = (ClampMin = 0, ClampMax = 10000, Units = "cm/s"))
+	float DefaultLaunchSpeed = 1000.0f;
+
+	/** Constructor */
+	USideScrollingCharacterMovementComponent();
+
+	/** Drops through the one way platform we're standing on. Returns false if we're not standing on one */
+	bool DropThroughFloor();
+
+	/** Stops passing through all one way platforms */
+	void ClearPassThroughPlatforms();
+
+	/** Returns true if the component belongs to a one way platform */
+	bool IsOneWayPlatform(const UPrimitiveComponent* Component) const;
+
+protected:
+
+	/** Ticks after moving platforms */
+	virtual void BeginPlay() override;
+
+	/** Continues the move through one way platforms that weren't hit from above */
+	virtual bool MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit = nullptr, ETeleportType Teleport = ETeleportType::None) override;
+
+	/** Stops ignoring platforms we've cleared and checks for launch surfaces */
+	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
+
+	/** Returns true if the blocking hit is on a one way platform we should pass through */
+	bool ShouldPassThrough(const FHitResult& Hit) const;
+
+	/** Adds the platform to the move ignore list */
+	void StartPassingThrough(UPrimitiveComponent* Platform);
+
+	/** Launches the character if it's standing on a launch surface */
+	void CheckForLaunchSurface();
+};
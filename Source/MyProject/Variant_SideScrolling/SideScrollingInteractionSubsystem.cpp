@@ -0,0 +1,270 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "SideScrollingInteractionSubsystem.h"
+#include "MyProjectCollisionChannels.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/ShapeComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interaction Candidate Update"), STAT_InteractionCandidateUpdate, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interaction Queries"), STAT_InteractionQueries, STATGROUP_Game);
+
+namespace SideScrollingInteraction
+{
+	static TAutoConsoleVariable<bool> CVarDebugDraw(
+		TEXT("MyProject.Interaction.Debug"),
+		false,
+		TEXT("If true, draws interaction query radii and candidates, and shows the proximity query rate"),
+		ECVF_Cheat);
+
+	static TAutoConsoleVariable<bool> CVarHighlight(
+		TEXT("MyProject.Interaction.Highlight"),
+		false,
+		TEXT("If true, the best interaction candidate is rendered to custom depth so it can be outlined. Needs an outline post process material reading the stencil"),
+		ECVF_Default);
+}
+
+void USideScrollingInteractionSubsystem::RegisterInteractor(AActor* Interactor, float Radius, float QueryInterval)
+{
+	if (!Interactor)
+	{
+		return;
+	}
+
+	FInteractor& State = Interactors.FindOrAdd(Interactor);
+	State.Actor = Interactor;
+	State.Radius = Radius;
+	State.QueryInterval = QueryInterval;
+	State.NextQueryTime = 0.0;
+}
+
+void USideScrollingInteractionSubsystem::UnregisterInteractor(AActor* Interactor)
+{
+	FInteractor State;
+
+	if (Interactors.RemoveAndCopyValue(Interactor, State))
+	{
+		SetHighlighted(State.BestActor.Get(), false);
+	}
+}
+
+ISideScrollingInteractable* USideScrollingInteractionSubsystem::GetBestCandidate(AActor* Interactor) const
+{
+	const FInteractor* State = Interactors.Find(Interactor);
+
+	return State ? State->Best.Get() : nullptr;
+}
+
+void USideScrollingInteractionSubsystem::UpdateCandidates(FInteractor& Interactor)
+{
+	AActor* Actor = Interactor.Actor.Get();
+	const FVector Location = Actor->GetActorLocation();
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(InteractionCandidates), false, Actor);
+
+	// only look for NPCs and interaction volumes
+	OverlapBuffer.Reset();
+	GetWorld()->OverlapMultiByObjectType(OverlapBuffer, Location, FQuat::Identity, MyProjectCollision::InteractionObjects(), FCollisionShape::MakeSphere(Interactor.Radius), QueryParams);
+
+	++QueriesSinceSample;
+	INC_DWORD_STAT(STAT_InteractionQueries);
+
+	Interactor.Candidates.Reset();
+
+	AActor* BestActor = nullptr;
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+
+	for (const FOverlapResult& Overlap : OverlapBuffer)
+	{
+		AActor* Candidate = Overlap.GetActor();
+
+		// skip actors we've already added through another component, and anything we can't interact with
+		if (!Candidate || Interactor.Candidates.Contains(Candidate) || !Cast<ISideScrollingInteractable>(Candidate))
+		{
+			continue;
+		}
+
+		Interactor.Candidates.Add(Candidate);
+
+		// prefer the closest candidate
+		const double DistanceSquared = FVector::DistSquared(Location, Candidate->GetActorLocation());
+
+		if (DistanceSquared < BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			BestActor = Candidate;
+		}
+	}
+
+	// move the highlight if the best candidate changed
+	if (BestActor != Interactor.BestActor.Get())
+	{
+		SetHighlighted(Interactor.BestActor.Get(), false);
+		SetHighlighted(BestActor, SideScrollingInteraction::CVarHighlight.GetValueOnGameThread());
+
+		Interactor.BestActor = BestActor;
+		Interactor.Best = Cast<ISideScrollingInteractable>(BestActor);
+	}
+}
+
+void USideScrollingInteractionSubsystem::SetHighlighted(AActor* Actor, bool bHighlighted)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	Actor->ForEachComponent<UPrimitiveComponent>(false, [this, bHighlighted](UPrimitiveComponent* Primitive)
+	{
+		// skip collision only shapes, such as interaction volumes
+		if (Primitive->IsA<UShapeComponent>())
+		{
+			return;
+		}
+
+		if (bHighlighted)
+		{
+			FHighlightedPrimitive& Highlighted = HighlightedPrimitives.FindOrAdd(Primitive);
+
+			// save the primitive's own settings the first time it's highlighted
+			if (Highlighted.NumHighlights++ == 0)
+			{
+				Highlighted.Primitive = Primitive;
+				Highlighted.bRenderCustomDepth = Primitive->bRenderCustomDepth;
+				Highlighted.StencilValue = Primitive->CustomDepthStencilValue;
+
+				Primitive->SetCustomDepthStencilValue(HighlightStencilValue);
+				Primitive->SetRenderCustomDepth(true);
+			}
+
+		} else {
+
+			// only touch primitives we highlighted
+			FHighlightedPrimitive* Highlighted = HighlightedPrimitives.Find(Primitive);
+
+			if (Highlighted && --Highlighted->NumHighlights == 0)
+			{
+				RestoreCustomDepth(*Highlighted);
+				HighlightedPrimitives.Remove(Primitive);
+			}
+		}
+	});
+}
+
+void USideScrollingInteractionSubsystem::RestoreCustomDepth(const FHighlightedPrimitive& Highlighted)
+{
+	if (UPrimitiveComponent* Primitive = Highlighted.Primitive.Get())
+	{
+		Primitive->SetCustomDepthStencilValue(Highlighted.StencilValue);
+		Primitive->SetRenderCustomDepth(Highlighted.bRenderCustomDepth);
+	}
+}
+
+void USideScrollingInteractionSubsystem::DrawDebug() const
+{
+	UWorld* World = GetWorld();
+
+	for (const TPair<TObjectKey<AActor>, FInteractor>& Pair : Interactors)
+	{
+		const FInteractor& Interactor = Pair.Value;
+		const AActor* Actor = Interactor.Actor.Get();
+
+		if (!Actor)
+		{
+			continue;
+		}
+
+		const FVector Location = Actor->GetActorLocation();
+
+		DrawDebugSphere(World, Location, Interactor.Radius, 16, FColor::Yellow);
+
+		for (const TWeakObjectPtr<AActor>& Candidate : Interactor.Candidates)
+		{
+			if (const AActor* CandidateActor = Candidate.Get())
+			{
+				DrawDebugLine(World, Location, CandidateActor->GetActorLocation(), CandidateActor == Interactor.BestActor.Get() ? FColor::Green : FColor::White, false, -1.0f, 0, 2.0f);
+			}
+		}
+	}
+
+	if (GEngine)
+	{
+		GEngine->AddOnScreenDebugMessage(INDEX_NONE, 0.0f, FColor::Yellow, FString::Printf(TEXT("Interaction: %d interactors, %.1f queries/s"), Interactors.Num(), QueriesPerSecond));
+	}
+}
+
+void USideScrollingInteractionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_InteractionCandidateUpdate);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (auto It = Interactors.CreateIterator(); It; ++It)
+	{
+		FInteractor& Interactor = It.Value();
+
+		// drop interactors that were destroyed without unregistering
+		if (!Interactor.Actor.IsValid())
+		{
+			SetHighlighted(Interactor.BestActor.Get(), false);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Now >= Interactor.NextQueryTime)
+		{
+			Interactor.NextQueryTime = Now + Interactor.QueryInterval;
+			UpdateCandidates(Interactor);
+		}
+	}
+
+	// forget highlighted primitives that were destroyed while highlighted
+	for (auto It = HighlightedPrimitives.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().Primitive.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// sample the query rate once per second
+	if (Now - QueryRateSampleTime >= 1.0)
+	{
+		QueriesPerSecond = static_cast<float>(QueriesSinceSample / (Now - QueryRateSampleTime));
+		QueriesSinceSample = 0;
+		QueryRateSampleTime = Now;
+	}
+
+	if (SideScrollingInteraction::CVarDebugDraw.GetValueOnGameThread())
+	{
+		DrawDebug();
+	}
+}
+
+TStatId USideScrollingInteractionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USideScrollingInteractionSubsystem, STATGROUP_Tickables);
+}
+
+void USideScrollingInteractionSubsystem::Deinitialize()
+{
+	// hand the custom depth settings back to any primitives still highlighted
+	for (const TPair<TObjectKey<UPrimitiveComponent>, FHighlightedPrimitive>& Pair : HighlightedPrimitives)
+	{
+		RestoreCustomDepth(Pair.Value);
+	}
+
+	HighlightedPrimitives.Empty();
+	Interactors.Empty();
+	OverlapBuffer.Empty();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakInterfacePtr.h"
+#include "SideScrollingInteractable.h"
+#include "SideScrollingInteractionSubsystem.generated.h"
+
+/**
+ *  Keeps a small set of nearby interaction candidates for each registered interactor.
+ *  Candidates are refreshed by a low frequency proximity query, and the best candidate is cached,
+ *  so interaction input resolves in constant time without running any queries.
+ *  When MyProject.Interaction.Highlight is set, the best candidate is rendered to custom depth with HighlightStencilValue
+ *  so a post process material can outline it. The candidate's own custom depth settings are restored afterwards.
+ *  Set MyProject.Interaction.Debug to draw the candidates and show the query rate.
+ */
+UCLASS()
+class USideScrollingInteractionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Interaction state for a registered interactor */
+	struct FInteractor
+	{
+		/** Interacting actor */
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Proximity query radius */
+		float Radius = 0.0f;
+
+		/** Time between proximity queries */
+		float QueryInterval = 0.0f;
+
+		/** World time of the next proximity query */
+		double NextQueryTime = 0.0;
+
+		/** Interactables found by the last query */
+		TArray<TWeakObjectPtr<AActor>, TInlineAllocator<8>> Candidates;
+
+		/** Closest candidate */
+		TWeakObjectPtr<AActor> BestActor;
+
+		/** Interface on the closest candidate */
+		TWeakInterfacePtr<ISideScrollingInteractable> Best;
+	};
+
+	/** Custom depth state of a highlighted primitive, restored when the highlight is removed */
+	struct FHighlightedPrimitive
+	{
+		/** Highlighted primitive */
+		TWeakObjectPtr<UPrimitiveComponent> Primitive;
+
+		/** Custom depth settings before the highlight */
+		bool bRenderCustomDepth = false;
+		int32 StencilValue = 0;
+
+		/** Number of interactors highlighting the primitive */
+		int32 NumHighlights = 0;
+	};
+
+	/** Registered interactors */
+	TMap<TObjectKey<AActor>, FInteractor> Interactors;
+
+	/** Primitives currently highlighted, with their saved custom depth state */
+	TMap<TObjectKey<UPrimitiveComponent>, FHighlightedPrimitive> HighlightedPrimitives;
+
+	/** Proximity queries run since the query rate was last sampled */
+	int32 QueriesSinceSample = 0;
+
+	/** World time the query rate was last sampled */
+	double QueryRateSampleTime = 0.0;
+
+	/** Proximity queries per second, for the debug overlay */
+	float QueriesPerSecond = 0.0f;
+
+	/** Overlap results buffer, reused between queries */
+	TArray<FOverlapResult> OverlapBuffer;
+
+public:
+
+	/** Custom depth stencil value used to highlight the best candidate */
+	static constexpr int32 HighlightStencilValue = 1;
+
+	/** Starts tracking interaction candidates around the actor */
+	void RegisterInteractor(AActor* Interactor, float Radius, float QueryInterval);
+
+	/** Stops tracking candidates for the actor and clears its highlight */
+	void UnregisterInteractor(AActor* Interactor);
+
+	/** Returns the cached best interaction candidate for the actor, or nullptr if there's none */
+	ISideScrollingInteractable* GetBestCandidate(AActor* Interactor) const;
+
+protected:
+
+	/** Runs the proximity query for the interactor and updates its best candidate */
+	void UpdateCandidates(FInteractor& Interactor);
+
+	/** Turns the custom depth highlight on or off for all primitives on the actor. Turning it off restores their previous custom depth settings */
+	void SetHighlighted(AActor* Actor, bool bHighlighted);
+
+	/** Restores the saved custom depth settings of a primitive */
+	static void RestoreCustomDepth(const FHighlightedPrimitive& Highlighted);
+
+	/** Draws the candidates and query rate */
+	void DrawDebug() const;
+
+public:
+
+	/** Refreshes the candidate sets that are due */
+	virtual void Tick(float DeltaTime) override;
+
+	/** Returns the stat ID for this tickable */
+	virtual TStatId GetStatId() const override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+};
@@ -7,6 +7,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/PlayerStart.h"
 #include "SideScrollingCharacter.h"
+#include "SideScrollingCharacterMovementComponent.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
 #include "Blueprint/UserWidget.h"
@@ -17,23 +18,21 @@ void ASideScrollingPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// cache the player start so we don't need to look it up on every respawn
+	TArray<AActor*> ActorList;
+	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerStart::StaticClass(), ActorList);
+
+	if (ActorList.Num() > 0)
+	{
+		PlayerStartTransform = ActorList[0]->GetActorTransform();
+		bHasPlayerStart = true;
+	}
+
 	// only spawn touch controls on local player controllers
 	if (ShouldUseTouchControls() && IsLocalPlayerController())
 	{
-		// spawn the mobile controls widget
-		MobileControlsWidget = CreateWidget<UUserWidget>(this, MobileControlsWidgetClass);
-
-		if (MobileControlsWidget)
-		{
-			// add the controls to the player screen
-			MobileControlsWidget->AddToPlayerScreen(0);
-
-		} else {
-
-			UE_LOG(LogMyProject, Error, TEXT("Could not spawn mobile controls widget."));
-
-		}
-
+		// load and spawn the mobile controls widget
+		MobileControls.Load(this, MobileControlsWidgetClass);
 	}
 }
 
@@ -72,18 +71,30 @@ void ASideScrollingPlayerController::OnPossess(APawn* InPawn)
 	InPawn->OnDestroyed.AddDynamic(this, &ASideScrollingPlayerController::OnPawnDestroyed);
 }
 
-void ASideScrollingPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
+bool ASideScrollingPlayerController::RespawnCharacter(ASideScrollingCharacter* FallenCharacter)
 {
-	// find the player start
-	TArray<AActor*> ActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerStart::StaticClass(), ActorList);
+	if (!bHasPlayerStart)
+	{
+		return false;
+	}
 
-	if (ActorList.Num() > 0)
+	// move the existing character back to the player start instead of spawning a new one
+	FallenCharacter->StopJumping();
+	FallenCharacter->GetSideScrollingMovement()->ClearPassThroughPlatforms();
+	FallenCharacter->SetActorTransform(PlayerStartTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+	FallenCharacter->GetCharacterMovement()->StopMovementImmediately();
+	FallenCharacter->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+
+	return true;
+}
+
+void ASideScrollingPlayerController::OnPawnDestroyed(AActor* DestroyedActor)
+{
+	if (bHasPlayerStart)
 	{
 		// spawn a character at the player start
-		const FTransform SpawnTransform = ActorList[0]->GetActorTransform();
-
-		if (ASideScrollingCharacter* RespawnedCharacter = GetWorld()->SpawnActor<ASideScrollingCharacter>(CharacterClass, SpawnTransform))
+		if (ASideScrollingCharacter* RespawnedCharacter = GetWorld()->SpawnActor<ASideScrollingCharacter>(CharacterClass, PlayerStartTransform))
 		{
 			// possess the character
 			Possess(RespawnedCharacter);
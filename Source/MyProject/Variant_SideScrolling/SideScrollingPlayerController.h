@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "MobileControlsLoader.h"
 #include "EnhancedInput/Public/InputAction.h"
 #include "SideScrollingPlayerController.generated.h"
 
@@ -13,6 +14,7 @@ class UInputMappingContext;
 /**
  *  A simple Side Scrolling Player Controller
  *  Manages input mappings
+ *  Resets the player character at the player start when it falls out of the world
  *  Respawns the player pawn at the player start if it is destroyed
  */
 UCLASS(abstract, Config="Game")
@@ -30,13 +32,13 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input|Input Mappings")
 	TArray<UInputMappingContext*> MobileExcludedMappingContexts;
 
-	/** Mobile controls widget to spawn */
+	/** Mobile controls widget to spawn. Soft referenced so it's only loaded when touch controls are in use, asynchronously if enabled in the Asset Loading settings */
 	UPROPERTY(EditAnywhere, Category="Input|Touch Controls")
-	TSubclassOf<UUserWidget> MobileControlsWidgetClass;
+	TSoftClassPtr<UUserWidget> MobileControlsWidgetClass;
 
-	/** Pointer to the mobile controls widget */
+	/** Loads and spawns the mobile controls widget */
 	UPROPERTY()
-	TObjectPtr<UUserWidget> MobileControlsWidget;
+	FMobileControlsLoader MobileControls;
 
 	/** If true, the player will use UMG touch controls even if not playing on mobile platforms */
 	UPROPERTY(EditAnywhere, Config, Category = "Input|Touch Controls")
@@ -46,6 +48,12 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Respawn")
 	TSubclassOf<ASideScrollingCharacter> CharacterClass;
 
+	/** Player start transform, cached on BeginPlay so respawns don't need to search for it */
+	FTransform PlayerStartTransform;
+
+	/** If true, a player start was found on BeginPlay */
+	bool bHasPlayerStart = false;
+
 protected:
 
 	/** Gameplay initialization */
@@ -57,6 +65,13 @@ protected:
 	/** Pawn initialization */
 	virtual void OnPossess(APawn* InPawn) override;
 
+public:
+
+	/** Resets the character in place at the player start. Returns false if there's no player start to reset to */
+	bool RespawnCharacter(ASideScrollingCharacter* FallenCharacter);
+
+protected:
+
 	/** Called if the possessed pawn is destroyed */
 	UFUNCTION()
 	void OnPawnDestroyed(AActor* DestroyedActor);